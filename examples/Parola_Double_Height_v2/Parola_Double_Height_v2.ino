@@ -15,8 +15,9 @@
 //  n/2+1 ... n-2 n-1 n   -> this direction top row
 //  n/2 ... 3  2  1  0    <- this direction bottom row
 //
-// Sending the original string to the lower zone and the modified (+128) string to the
-// upper zone creates the complete message on the display.
+// The two zones are linked as a pair using setZonePair(). The text is only given to the
+// lower zone and the upper zone displays the same text with 128 added to each character,
+// animated in step with the lower zone.
 //
 // MD_MAX72XX library can be found at https://github.com/MajicDesigns/MD_MAX72XX
 //
@@ -75,12 +76,9 @@ const char *msgL[] =
   "0123456789",
   "`!@#$%^&*()_+-={};:'<>\"?,./|\\{}",
 };
-char *msgH; // allocated memory in setup()
 
 void setup(void)
 {
-  uint8_t max = 0;
-
 #if DEBUG
   Serial.begin(57600);
   PRINTS("\n[Double_Height_v2]");
@@ -109,12 +107,6 @@ void setup(void)
 #endif
   }
 
-  // work out the size of buffer required
-  for (uint8_t i = 0; i<ARRAY_SIZE(msgL); i++)
-    if (strlen(msgL[i]) > max) max = strlen(msgL[i]);
-
-  msgH = (char *)malloc(sizeof(char)*(max + 2));
-
   // initialise the LED display
   P.begin(NUM_ZONES);
 
@@ -128,49 +120,31 @@ void setup(void)
     P.setZoneEffect(ZONE_UPPER, true, PA_FLIP_UD);
     P.setZoneEffect(ZONE_UPPER, true, PA_FLIP_LR);
   }
+  P.setZonePair(ZONE_LOWER, ZONE_UPPER, 128);
+
   PRINT("\nFLIP_UD=", P.getZoneEffect(ZONE_UPPER, PA_FLIP_UD));
   PRINT("\nFLIP_LR=", P.getZoneEffect(ZONE_UPPER, PA_FLIP_LR));
   PRINT("\nSCROLL_LEFT=", SCROLL_LEFT);
 }
 
-void createHString(char *pH, const char *pL)
-{
-  for (; *pL != '\0'; pL++)
-    *pH++ = *pL | 0x80;   // offset character
-
-  *pH = '\0'; // terminate the string
-}
-
 void loop(void)
 {
   static uint8_t cycle = 0;
 
   P.displayAnimate();
 
-  if (P.getZoneStatus(ZONE_LOWER) && P.getZoneStatus(ZONE_UPPER))
+  if (P.getZoneStatus(ZONE_LOWER))
   {
     PRINT("\n", cycle);
     PRINT(": ", msgL[cycle]);
 
-    // set up the string
-    createHString(msgH, msgL[cycle]);
-
     P.displayClear();
     if (invertUpperZone)
-    {
-      P.displayZoneText(ZONE_UPPER, msgH, PA_CENTER, SCROLL_SPEED, PAUSE_TIME, scrollUpper, scrollLower);
       P.displayZoneText(ZONE_LOWER, msgL[cycle], PA_CENTER, SCROLL_SPEED, PAUSE_TIME, scrollUpper, scrollLower);
-    }
     else
-    {
       P.displayZoneText(ZONE_LOWER, msgL[cycle], PA_LEFT, SCROLL_SPEED, PAUSE_TIME, scrollLower, scrollLower);
-      P.displayZoneText(ZONE_UPPER, msgH, PA_LEFT, SCROLL_SPEED, PAUSE_TIME, scrollUpper, scrollUpper);
-    }
 
     // prepare for next pass
     cycle = (cycle + 1) % ARRAY_SIZE(msgL);
-
-    // synchronize the start and run the display
-    P.synchZoneStart();
   }
 }
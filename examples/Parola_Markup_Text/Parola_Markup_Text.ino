@@ -0,0 +1,83 @@
+// Program to demonstrate the MD_Parola library
+//
+// Change the font, inversion and character spacing part way through a
+// message using markup codes in the text (see setMarkup()). Each message
+// is displayed in one animation, without splitting it over several zones
+// or display cycles.
+//
+// Markup is not compiled in by default, so ENA_MARKUP must be set to 1
+// in MD_Parola.h to compile this example.
+//
+// MD_MAX72XX library can be found at https://github.com/MajicDesigns/MD_MAX72XX
+//
+
+#include <MD_Parola.h>
+#include <MD_MAX72xx.h>
+#include <SPI.h>
+
+#if !ENA_MARKUP
+#error "Set ENA_MARKUP to 1 in MD_Parola.h to use markup codes"
+#endif
+
+// Define the number of devices we have in the chain and the hardware interface
+// NOTE: These pin numbers will probably not work with your hardware and may
+// need to be adapted
+#define HARDWARE_TYPE MD_MAX72XX::PAROLA_HW
+#define MAX_DEVICES 11
+
+#define CLK_PIN   13
+#define DATA_PIN  11
+#define CS_PIN    10
+
+// Hardware SPI connection
+MD_Parola P = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+// Arbitrary output pins
+// MD_Parola P = MD_Parola(HARDWARE_TYPE, DATA_PIN, CLK_PIN, CS_PIN, MAX_DEVICES);
+
+#define SPEED_TIME 25
+#define PAUSE_TIME 2000
+
+// Narrow digits, selected in the messages as markup font 1
+MD_MAX72XX::fontType_t narrowDigits[] PROGMEM =
+{
+  'F', 1, '0', '9', 8,
+  3, 0x3e, 0x41, 0x3e,  // 0
+  3, 0x42, 0x7f, 0x40,  // 1
+  3, 0x62, 0x51, 0x4e,  // 2
+  3, 0x41, 0x49, 0x36,  // 3
+  3, 0x0f, 0x08, 0x7f,  // 4
+  3, 0x4f, 0x49, 0x31,  // 5
+  3, 0x3e, 0x49, 0x32,  // 6
+  3, 0x01, 0x79, 0x07,  // 7
+  3, 0x36, 0x49, 0x36,  // 8
+  3, 0x26, 0x49, 0x3e,  // 9
+};
+
+// A user defined arrow, shown with ~U
+const uint8_t arrow[] = { 5, 0x08, 0x08, 0x2a, 0x1c, 0x08 };
+#define ARROW "\x01"
+
+const char *msg[] =
+{
+  "Next ~Itrain~i at ~F110~F0:~F115",
+  "Platform ~F14~F0 " "~U" ARROW " ~S3slow~Sz",
+  "~~ ~Imind the gap~i ~~",
+};
+uint8_t curMsg = 0;
+
+void setup(void)
+{
+  P.begin();
+  P.addChar(ARROW[0], arrow);
+  P.setMarkupFont(1, narrowDigits);
+  P.setMarkup(true);
+}
+
+void loop(void)
+{
+  if (P.displayAnimate())
+  {
+    P.displayText(msg[curMsg], PA_CENTER, SPEED_TIME, PAUSE_TIME, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+    curMsg = (curMsg + 1) % ARRAY_SIZE(msg);
+  }
+}
@@ -28,9 +28,10 @@ MD_Parola P = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
 void setup(void)
 {
   P.begin();
-  P.print("Hello!");
+  P.println("Hello!");
 }
 
 void loop(void)
 {
+  P.displayAnimate();
 }
\ No newline at end of file
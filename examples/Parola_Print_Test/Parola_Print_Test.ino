@@ -31,24 +31,32 @@ void setup(void)
   P.begin();
 }
 
+void wait(void)
+// keep the display running while we wait
+{
+  uint32_t timeStart = millis();
+
+  while (millis() - timeStart < WAIT_TIME)
+    P.displayAnimate();
+}
+
 void loop(void)
 {
-  P.print("Hello");
-  delay(WAIT_TIME);
-  P.print(1234, DEC);
-  delay(WAIT_TIME);
-  P.print(1234, HEX);
-  delay(WAIT_TIME);
-  P.print(12.5);      // float not supported by Arduino Print class
-  delay(WAIT_TIME);
-  P.print(9876l);
-  delay(WAIT_TIME);
-  P.println("end");   // only get the /r/n characters - avoid using println
-  delay(WAIT_TIME);
+  P.println("Hello");
+  wait();
+  P.println(1234, DEC);
+  wait();
+  P.println(1234, HEX);
+  wait();
+  P.println(12.5);    // float not supported by Arduino Print class
+  wait();
+  P.print(98);        // a line can be built with several prints ...
+  P.print(76l);
+  P.flush();          // ... and displayed with flush() or a newline
+  wait();
   P.write('A');
-  delay(WAIT_TIME);
   P.write('B');
-  delay(WAIT_TIME);
   P.write('C');
-  delay(WAIT_TIME);
-}
\ No newline at end of file
+  P.write('\n');
+  wait();
+}
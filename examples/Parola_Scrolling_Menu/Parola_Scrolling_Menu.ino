@@ -262,11 +262,11 @@ bool display(MD_Menu::userDisplayAction_t action, char *msg)
     break;
 
   case MD_Menu::DISP_L0:
-    // P.print(msg);    // only one zone, no line 0
+    // P.println(msg);    // only one zone, no line 0
     break;
 
   case MD_Menu::DISP_L1:
-    P.print(msg);
+    P.println(msg);
     break;
   }
 
@@ -440,6 +440,8 @@ void loop()
       P.displayReset();
     }
   }
+  else
+    P.displayAnimate();     // show the menu text
 
   readSerial();   // receive new serial characters
 }
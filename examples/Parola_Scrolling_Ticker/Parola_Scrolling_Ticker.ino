@@ -0,0 +1,72 @@
+// Program to demonstrate the MD_Parola library
+//
+// Scroll an endless ticker using setTextSource(). The text is made up one
+// byte at a time as the display needs it, so no message buffer is required
+// however long the ticker runs. Characters typed into the Serial Monitor
+// are added to the ticker as they arrive.
+//
+// MD_MAX72XX library can be found at https://github.com/MajicDesigns/MD_MAX72XX
+//
+
+#include <MD_Parola.h>
+#include <MD_MAX72xx.h>
+#include <SPI.h>
+
+// Define the number of devices we have in the chain and the hardware interface
+// NOTE: These pin numbers will probably not work with your hardware and may
+// need to be adapted
+#define HARDWARE_TYPE MD_MAX72XX::PAROLA_HW
+#define MAX_DEVICES 11
+
+#define CLK_PIN   13
+#define DATA_PIN  11
+#define CS_PIN    10
+
+// Hardware SPI connection
+MD_Parola P = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+// Arbitrary output pins
+// MD_Parola P = MD_Parola(HARDWARE_TYPE, DATA_PIN, CLK_PIN, CS_PIN, MAX_DEVICES);
+
+#define SPEED_TIME 25
+
+// Stock prices wander up and down a little each time they are shown
+const char *stock[] = { "ABC", "DEF", "GHI", "JKL" };
+int16_t price[] = { 1000, 2500, 420, 7300 };
+
+char quote[16];         // the quote currently being sent to the display
+uint8_t quotePos = 0;   // next byte of the quote to send
+uint8_t curStock = 0;
+
+int16_t tickerSource(void)
+// Supply the next byte of the ticker text
+{
+  // anything typed in goes first
+  if (Serial.available())
+    return(Serial.read());
+
+  // make up the next quote when the last one has been sent
+  if (quote[quotePos] == '\0')
+  {
+    price[curStock] += random(-20, 21);
+    sprintf(quote, "%s %d.%02d   ", stock[curStock], price[curStock] / 100, price[curStock] % 100);
+    curStock = (curStock + 1) % ARRAY_SIZE(stock);
+    quotePos = 0;
+  }
+
+  return(quote[quotePos++]);
+}
+
+void setup(void)
+{
+  Serial.begin(57600);
+  Serial.print("\n[Parola Scrolling Ticker]\nType text to add to the ticker");
+
+  P.begin();
+  P.displayScroll(nullptr, PA_LEFT, PA_SCROLL_LEFT, SPEED_TIME);
+  P.setTextSource(tickerSource);
+}
+
+void loop(void)
+{
+  P.displayAnimate();
+}
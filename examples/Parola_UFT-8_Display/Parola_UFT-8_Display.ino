@@ -1,7 +1,9 @@
 // Program to demonstrate the MD_Parola library
 //
-// Demonstrates how UTF-8 multi-byte characters can be mapped to Extended ASCII
-// characters that can be displayed with a suitable font file.
+// Demonstrates how UTF-8 multi-byte characters can be displayed directly with
+// a suitable font file. The library decodes the UTF-8 text as it is displayed.
+// Characters up to 255 are the ISO 8859-1 (Latin-1) characters in the font,
+// others can be added as user defined characters.
 //
 // MD_MAX72XX library can be found at https://github.com/MajicDesigns/MD_MAX72XX
 //
@@ -42,85 +44,21 @@ const uint16_t PAUSE_TIME = 2000;
 #endif
 
 // Global variables
-char	pc[][20] =
+const char *pc[] =
 {
   "abc…ABC",
-//  "äöüßÄÖÜ",
-//  "50€/kg³",
-//  "Español",
-//  "30m/s²",
-//  "Français",
-//  "20µs/°C",
+  "äöüßÄÖÜ",
+  "50€/kg³",
+  "Español",
+  "30m/s²",
+  "Français",
+  "20µs/°C",
 };
 
-uint8_t utf8Ascii(uint8_t ascii)
-// Convert a single Character from UTF8 to Extended ASCII according to ISO 8859-1,
-// also called ISO Latin-1. Codes 128-159 contain the Microsoft Windows Latin-1
-// extended characters:
-// - codes 0..127 are identical in ASCII and UTF-8
-// - codes 160..191 in ISO-8859-1 and Windows-1252 are two-byte characters in UTF-8
-//                 + 0xC2 then second byte identical to the extended ASCII code.
-// - codes 192..255 in ISO-8859-1 and Windows-1252 are two-byte characters in UTF-8
-//                 + 0xC3 then second byte differs only in the first two bits to extended ASCII code.
-// - codes 128..159 in Windows-1252 are different, but usually only the €-symbol will be needed from this range.
-//                 + The euro symbol is 0x80 in Windows-1252, 0xa4 in ISO-8859-15, and 0xe2 0x82 0xac in UTF-8.
-//
-// Modified from original code at http://playground.arduino.cc/Main/Utf8ascii
-// Extended ASCII encoding should match the characters at http://www.ascii-code.com/
-//
-// Return "0" if a byte has to be ignored.
-{
-  static uint8_t cPrev;
-  uint8_t c = '\0';
-
-  PRINTX("\nutf8Ascii 0x", ascii);
-
-  if (ascii < 0x7f)   // Standard ASCII-set 0..0x7F, no conversion
-  {
-    cPrev = '\0';
-    c = ascii;
-  }
-  else
-  {
-    switch (cPrev)  // Conversion depending on preceding UTF8-character
-    {
-    case 0xC2: c = ascii;  break;
-    case 0xC3: c = ascii | 0xC0;  break;
-    case 0x82: if (ascii==0xAC) c = 0x80; // Euro symbol special case
-    case 0xE2: 
-      switch (ascii)
-      {
-      case 0x80: c = 133;  break;// ellipsis special case
-      }
-      break;
-
-    default: PRINTS("!Unhandled! ");
-    }
-    cPrev = ascii;   // save last char
-  }
-
-  PRINTX(" -> 0x", c);
-
-  return(c);
-}
-
-void utf8Ascii(char* s)
-// In place conversion UTF-8 string to Extended ASCII
-// The extended ASCII string is always shorter.
-{
-  uint8_t c;
-  char *cp = s;
-
-  PRINT("\nConverting: ", s);
-
-  while (*s != '\0')
-  {
-    c = utf8Ascii(*s++);
-    if (c != '\0')
-      *cp++ = c;
-  }
-  *cp = '\0';   // terminate the new string
-}
+// The font has the Windows-1252 euro and ellipsis characters, which are not
+// in ISO 8859-1, so they are copied to user characters with their UTF-8 codes
+uint8_t euro[COL_SIZE + 2];
+uint8_t ellipsis[COL_SIZE + 2];
 
 void setup(void)
 {
@@ -129,15 +67,20 @@ void setup(void)
 #endif
   PRINTS("\n[Parola UTF-8 display Test]");
 
-  // Do one time in-place conversion of the strings to be displayed
-  for (uint8_t i=0; i<ARRAY_SIZE(pc); i++)
-    utf8Ascii(pc[i]);
-
   // Initialise the Parola library
   P.begin();
   P.setInvert(false);
   P.setPause(PAUSE_TIME);
   P.setFont(ExtASCII);
+  P.setUTF8(true);
+
+  MD_MAX72XX *mx = P.getGraphicObject();
+
+  mx->setFont(ExtASCII);
+  euro[0] = mx->getChar(0x80, sizeof(euro) - 1, &euro[1]);
+  ellipsis[0] = mx->getChar(0x85, sizeof(ellipsis) - 1, &ellipsis[1]);
+  P.addChar(0x20ac, euro);
+  P.addChar(0x2026, ellipsis);
 }
 
 void loop(void)
@@ -146,6 +89,8 @@ void loop(void)
   static uint16_t  idx = 0;
   static bool showMessage = true;
 
+  P.displayAnimate();
+
   if (millis() - timeLast <= PAUSE_TIME)
     return;
 
@@ -156,7 +101,7 @@ void loop(void)
     // show the strings with the UTF-8 characters
     PRINT("\nS:", idx);
     PRINT(" - ", pc[idx]);
-    P.print(pc[idx]);
+    P.println(pc[idx]);
 
     // Set the display for the next string.
     idx++;
@@ -174,7 +119,7 @@ void loop(void)
     sprintf(szMsg, "%3d %c", idx, idx);
     PRINT("\nC:", idx);
     PRINT(" - ", szMsg);
-    P.print(szMsg);
+    P.println(szMsg);
 
     // set up for next character
     idx++;
@@ -0,0 +1,101 @@
+// Program to demonstrate the MD_Parola library
+//
+// Define a new text effect in the application using setUserEffect().
+// The text drops in from the top of the display and bounces before settling,
+// then lifts out through the top.
+//
+// MD_MAX72XX library can be found at https://github.com/MajicDesigns/MD_MAX72XX
+//
+
+#include <MD_Parola.h>
+#include <MD_MAX72xx.h>
+#include <SPI.h>
+
+// Define the number of devices we have in the chain and the hardware interface
+// NOTE: These pin numbers will probably not work with your hardware and may
+// need to be adapted
+#define HARDWARE_TYPE MD_MAX72XX::PAROLA_HW
+#define MAX_DEVICES 11
+
+#define CLK_PIN   13
+#define DATA_PIN  11
+#define CS_PIN    10
+
+// Hardware SPI connection
+MD_Parola P = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+// Arbitrary output pins
+// MD_Parola P = MD_Parola(HARDWARE_TYPE, DATA_PIN, CLK_PIN, CS_PIN, MAX_DEVICES);
+
+#define PA_BOUNCE PA_USER_1   // give the user effect a meaningful name
+
+// Vertical offset of the text for each animation frame
+const int8_t dropIn[] = { 8, 7, 5, 3, 0, 2, 3, 2, 0, 1, 0 };
+const int8_t liftOut[] = { 0, 1, 3, 5, 8 };
+
+void effectBounce(MD_PZone *z, bool bIn)
+{
+  if (bIn)
+  {
+    switch (z->getEffectState())
+    {
+    case MD_PZone::INITIALISE:
+      z->setEffectPosition(0);
+      z->setEffectState(MD_PZone::PUT_CHAR);
+      // fall through
+
+    case MD_PZone::PUT_CHAR:
+      {
+        int16_t pos = z->getEffectPosition();
+
+        z->commonPrint(dropIn[pos]);
+        if (++pos >= (int16_t)ARRAY_SIZE(dropIn))
+          z->setEffectState(MD_PZone::PAUSE);
+        else
+          z->setEffectPosition(pos);
+      }
+      break;
+
+    default:
+      z->setEffectState(MD_PZone::PAUSE);
+      break;
+    }
+  }
+  else  // exiting
+  {
+    switch (z->getEffectState())
+    {
+    case MD_PZone::PAUSE:
+      z->setEffectPosition(0);
+      z->setEffectState(MD_PZone::PUT_CHAR);
+      // fall through
+
+    case MD_PZone::PUT_CHAR:
+      {
+        int16_t pos = z->getEffectPosition();
+
+        z->commonPrint(liftOut[pos]);
+        if (++pos >= (int16_t)ARRAY_SIZE(liftOut))
+          z->setEffectState(MD_PZone::END);
+        else
+          z->setEffectPosition(pos);
+      }
+      break;
+
+    default:
+      z->setEffectState(MD_PZone::END);
+      break;
+    }
+  }
+}
+
+void setup(void)
+{
+  P.begin();
+  P.setUserEffect(PA_BOUNCE, effectBounce);
+}
+
+void loop(void)
+{
+  if (P.displayAnimate())
+    P.displayText("Bounce", PA_CENTER, P.getSpeed(), 1000, PA_BOUNCE, PA_BOUNCE);
+}
@@ -0,0 +1,92 @@
+// Program to demonstrate the MD_Parola library
+//
+// Rotate a list of messages in each zone using setPlaylist(), in the style
+// of a departure board. Each zone moves on to its next message by itself as
+// soon as the current one has finished, so loop() only runs the animation.
+//
+// Every 10 seconds the delayed service in the last zone is switched on or off
+// by changing the enabled flag of its playlist entry. The destination names
+// are read directly from PROGMEM.
+//
+// MD_MAX72XX library can be found at https://github.com/MajicDesigns/MD_MAX72XX
+//
+
+#include <MD_Parola.h>
+#include <MD_MAX72xx.h>
+#include <SPI.h>
+
+// Define the number of devices we have in the chain and the hardware interface
+// NOTE: These pin numbers will probably not work with your hardware and may
+// need to be adapted
+#define HARDWARE_TYPE MD_MAX72XX::PAROLA_HW
+#define MAX_DEVICES 12
+#define NUM_ZONES   4
+
+#define ZONE_SIZE (MAX_DEVICES/NUM_ZONES)   // integer multiple works best
+
+#define CLK_PIN   13
+#define DATA_PIN  11
+#define CS_PIN    10
+
+// Hardware SPI connection
+MD_Parola P = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+// Arbitrary output pins
+// MD_Parola P = MD_Parola(HARDWARE_TYPE, DATA_PIN, CLK_PIN, CS_PIN, MAX_DEVICES);
+
+#define SPEED_TIME  40
+#define PAUSE_TIME  2000
+
+// One playlist for each zone.
+// Entry fields are text, alignment, speed, pause, effect in, effect out, repeat, enabled, flash.
+playlistEntry_t platform[] =
+{
+  { "P1", PA_CENTER, SPEED_TIME, PAUSE_TIME, PA_SCROLL_DOWN, PA_SCROLL_UP, 1, true, false },
+  { "P2", PA_CENTER, SPEED_TIME, PAUSE_TIME, PA_SCROLL_DOWN, PA_SCROLL_UP, 1, true, false },
+};
+
+playlistEntry_t departs[] =
+{
+  { "10:15", PA_CENTER, SPEED_TIME, PAUSE_TIME, PA_OPENING, PA_CLOSING, 1, true, false },
+  { "10:42", PA_CENTER, SPEED_TIME, PAUSE_TIME, PA_OPENING, PA_CLOSING, 1, true, false },
+};
+
+const char destCentral[] PROGMEM = "Central";
+const char destAirport[] PROGMEM = "Airport";
+
+playlistEntry_t destination[] =
+{
+  { destCentral, PA_LEFT, SPEED_TIME, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT, 2, true, true },
+  { destAirport, PA_LEFT, SPEED_TIME, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT, 2, true, true },
+};
+
+playlistEntry_t status[] =
+{
+  { "On time", PA_CENTER, SPEED_TIME, PAUSE_TIME, PA_PRINT, PA_NO_EFFECT, 1, true, false },
+  { "Delayed", PA_CENTER, SPEED_TIME/2, PAUSE_TIME/4, PA_PRINT, PA_PRINT, 3, false, false },
+};
+
+void setup(void)
+{
+  P.begin(NUM_ZONES);
+  for (uint8_t i=0; i<NUM_ZONES; i++)
+    P.setZone(i, ZONE_SIZE*i, (ZONE_SIZE*(i+1))-1);
+
+  P.setPlaylist(0, platform, ARRAY_SIZE(platform));
+  P.setPlaylist(1, departs, ARRAY_SIZE(departs));
+  P.setPlaylist(2, destination, ARRAY_SIZE(destination));
+  P.setPlaylist(3, status, ARRAY_SIZE(status));
+}
+
+void loop(void)
+{
+  static uint32_t timeLast = 0;
+
+  P.displayAnimate();
+
+  // the change is picked up the next time the entry comes around
+  if (millis() - timeLast >= 10000)
+  {
+    timeLast = millis();
+    status[1].enabled = !status[1].enabled;
+  }
+}
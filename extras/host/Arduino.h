@@ -0,0 +1,98 @@
+/*
+Host build shim for the Arduino core functions used by MD_Parola.
+
+This file is not part of the Arduino library build. It allows the library
+source in src/ to be compiled and run on a workstation together with the
+virtual MD_MAX72XX in this folder. See README.md for details.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+// Program memory is ordinary memory on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define pgm_read_ptr(p)  (*(void * const *)(p))
+#define strlen_P strlen
+#define strcpy_P strcpy
+#define memcpy_P memcpy
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(PSTR(s)))
+
+#define DEC 10
+#define HEX 16
+
+#ifndef min
+#define min(a,b) ((a)<(b)?(a):(b))
+#endif
+#ifndef max
+#define max(a,b) ((a)>(b)?(a):(b))
+#endif
+
+// Clock
+// By default millis() returns a virtual clock that only moves when delay()
+// or hostAdvanceClock() is called, so animations run at full speed and the
+// results are repeatable. A different time source can be injected with
+// hostSetClock(); passing nullptr returns to the virtual clock.
+typedef uint32_t (*hostClock_t)(void);
+
+inline uint32_t &hostVirtualTime(void) { static uint32_t t = 0; return(t); }
+inline hostClock_t &hostClockSource(void) { static hostClock_t f = nullptr; return(f); }
+inline void hostSetClock(hostClock_t f) { hostClockSource() = f; }
+inline void hostAdvanceClock(uint32_t ms) { hostVirtualTime() += ms; }
+
+inline uint32_t millis(void) { return(hostClockSource() != nullptr ? hostClockSource()() : hostVirtualTime()); }
+inline uint32_t micros(void) { return(millis() * 1000UL); }
+inline void delay(uint32_t ms) { hostAdvanceClock(ms); }
+inline void yield(void) {}
+
+// Random numbers
+inline long random(long howbig) { return(howbig <= 0 ? 0 : rand() % howbig); }
+inline long random(long howsmall, long howbig) { return(howsmall >= howbig ? howsmall : howsmall + random(howbig - howsmall)); }
+inline void randomSeed(unsigned long seed) { srand(seed); }
+
+// Print class, enough for the library and the debug output macros
+class Print
+{
+public:
+  virtual ~Print(void) {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t *buffer, size_t size) { size_t n = 0; while (size--) n += write(*buffer++); return(n); }
+  size_t write(const char *str) { return(str == nullptr ? 0 : write((const uint8_t *)str, strlen(str))); }
+  virtual void flush(void) {}
+
+  size_t print(const char *s) { return(write(s)); }
+  size_t print(const __FlashStringHelper *s) { return(write((const char *)s)); }
+  size_t print(char c) { return(write((uint8_t)c)); }
+  size_t print(long n, int base = DEC) { char b[34]; snprintf(b, sizeof(b), base == HEX ? "%lX" : "%ld", n); return(write(b)); }
+  size_t print(unsigned long n, int base = DEC) { char b[34]; snprintf(b, sizeof(b), base == HEX ? "%lX" : "%lu", n); return(write(b)); }
+  size_t print(int n, int base = DEC) { return(print((long)n, base)); }
+  size_t print(unsigned int n, int base = DEC) { return(print((unsigned long)n, base)); }
+  size_t print(double d, int digits = 2) { char b[34]; snprintf(b, sizeof(b), "%.*f", digits, d); return(write(b)); }
+
+  size_t println(void) { return(write("\r\n")); }
+  template <typename T> size_t println(T v) { size_t n = print(v); return(n + println()); }
+  template <typename T> size_t println(T v, int f) { size_t n = print(v, f); return(n + println()); }
+};
+
+// Serial output goes to stdout
+class HardwareSerial : public Print
+{
+public:
+  void begin(unsigned long) {}
+  size_t write(uint8_t c) { return(fputc(c, stdout) == EOF ? 0 : 1); }
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
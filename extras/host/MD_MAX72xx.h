@@ -0,0 +1,238 @@
+/*
+Virtual MD_MAX72XX for the host build of MD_Parola.
+
+Implements the subset of the MD_MAX72XX interface used by the library on an
+in-memory framebuffer. Instead of driving hardware it counts the traffic a
+real display would see:
+- every setColumn() and getColumn() call made by the library.
+- every MAX7219 row write and the SPI bytes clocked into the chain. As in
+  the real library, a write to a column marks all the rows of that module
+  as changed, and writing one row clocks 2 bytes through every module in
+  the chain.
+
+The default font is a synthetic proportional font (codes 0-255, width 1-5
+columns, 'F' version 1 header) so that font handling is exercised without
+the font data from the MD_MAX72XX library.
+*/
+#pragma once
+
+#include <Arduino.h>
+#include <SPI.h>
+
+#define COL_SIZE 8  ///< column size in pixels for each module
+#define ROW_SIZE 8  ///< row size in pixels for each module
+
+class MD_MAX72XX
+{
+public:
+  enum moduleType_t { PAROLA_HW, GENERIC_HW, ICSTATION_HW, FC16_HW, DR0CR0RR0_HW, DR0CR0RR1_HW, DR0CR1RR0_HW, DR0CR1RR1_HW, DR1CR0RR0_HW, DR1CR0RR1_HW, DR1CR1RR0_HW, DR1CR1RR1_HW };
+  enum controlRequest_t { SHUTDOWN = 0, SCANLIMIT = 1, INTENSITY = 2, TEST = 3, DECODE = 4, UPDATE = 10, WRAPAROUND = 11 };
+  enum controlValue_t { OFF = 0, ON = 1 };
+  enum transformType_t { TSL, TSR, TSU, TSD, TFLR, TFUD, TRC, TINV, TNOP };
+  typedef const uint8_t fontType_t;
+
+  MD_MAX72XX(moduleType_t mod, uint8_t dataPin, uint8_t clkPin, uint8_t csPin, uint8_t numDevices = 1) : _numDevices(numDevices) {}
+  MD_MAX72XX(moduleType_t mod, uint8_t csPin, uint8_t numDevices = 1) : _numDevices(numDevices) {}
+  MD_MAX72XX(moduleType_t mod, SPIClass &spi, uint8_t csPin, uint8_t numDevices = 1) : _numDevices(numDevices) {}
+  ~MD_MAX72XX(void) { delete[] _col; delete[] _changed; }
+
+  bool begin(void)
+  {
+    _col = new uint8_t[getColumnCount()];
+    _changed = new uint8_t[_numDevices];
+    memset(_col, 0, getColumnCount());
+    memset(_changed, 0xff, _numDevices);
+    setFont(nullptr);
+    return(true);
+  }
+
+  // Control
+  bool control(controlRequest_t mode, int value) { return(control(0, _numDevices - 1, mode, value)); }
+  bool control(uint8_t dev, controlRequest_t mode, int value) { return(control(dev, dev, mode, value)); }
+  bool control(uint8_t startDev, uint8_t endDev, controlRequest_t mode, int value)
+  {
+    switch (mode)
+    {
+    case UPDATE:      _autoUpdate = (value == ON); if (_autoUpdate) flush(); break;
+    case WRAPAROUND:  _wrapAround = (value == ON); break;
+    default:          spiTransfers++; spiBytes += 2 * _numDevices; break;   // one register write to all devices
+    }
+    return(true);
+  }
+
+  uint8_t getDeviceCount(void) { return(_numDevices); }
+  uint16_t getColumnCount(void) { return(_numDevices * COL_SIZE); }
+
+  void update(controlValue_t mode) { control(UPDATE, mode); }
+  void update(void) { flush(); }
+  bool update(uint8_t buf) { if (buf >= _numDevices) return(false); flush(buf, buf); return(true); }
+
+  // Graphics
+  void clear(void) { clear(0, _numDevices - 1); }
+  void clear(uint8_t startDev, uint8_t endDev)
+  {
+    for (uint16_t c = startDev * COL_SIZE; c < (endDev + 1) * COL_SIZE; c++) put(c, 0);
+    autoUpdate();
+  }
+
+  uint8_t getColumn(uint16_t c) { getColumnCalls++; return(c < getColumnCount() ? _col[c] : 0); }
+  bool setColumn(uint16_t c, uint8_t value)
+  {
+    setColumnCalls++;
+    if (c >= getColumnCount()) return(false);
+    put(c, value);
+    autoUpdate();
+    return(true);
+  }
+
+  bool getPoint(uint8_t r, uint16_t c) { return(c < getColumnCount() && (_col[c] & (1 << r))); }
+  bool setPoint(uint8_t r, uint16_t c, bool state)
+  {
+    if (c >= getColumnCount() || r >= ROW_SIZE) return(false);
+    put(c, state ? _col[c] | (1 << r) : _col[c] & ~(1 << r));
+    autoUpdate();
+    return(true);
+  }
+
+  bool transform(transformType_t ttype) { return(transform(0, _numDevices - 1, ttype)); }
+  bool transform(uint8_t startDev, uint8_t endDev, transformType_t ttype)
+  {
+    uint16_t lo = startDev * COL_SIZE, hi = (endDev + 1) * COL_SIZE - 1;
+    uint8_t  x;
+
+    switch (ttype)
+    {
+    case TSL: x = _col[hi]; for (uint16_t c = hi; c > lo; c--) put(c, _col[c - 1]); put(lo, _wrapAround ? x : 0); break;
+    case TSR: x = _col[lo]; for (uint16_t c = lo; c < hi; c++) put(c, _col[c + 1]); put(hi, _wrapAround ? x : 0); break;
+    case TSU: for (uint16_t c = lo; c <= hi; c++) put(c, _col[c] >> 1); break;
+    case TSD: for (uint16_t c = lo; c <= hi; c++) put(c, _col[c] << 1); break;
+    case TINV: for (uint16_t c = lo; c <= hi; c++) put(c, ~_col[c]); break;
+    default: return(false);
+    }
+    autoUpdate();
+    return(true);
+  }
+
+  // Fonts
+  bool setFont(fontType_t *f) { setFontCalls++; _fontData = (f == nullptr ? sysFont() : f); loadFontInfo(); return(true); }
+  fontType_t *getFont(void) { return(_fontData); }
+  uint8_t getMaxFontWidth(void) { return(_fontMaxWidth); }
+  uint8_t getFontHeight(void) { return(_fontHeight); }
+  uint8_t getChar(uint16_t c, uint8_t size, uint8_t *buf)
+  {
+    uint32_t offset = _fontOffset;
+
+    getCharCalls++;
+    if (buf == nullptr) return(0);
+    if (c < _fontFirst || c > _fontLast) { memset(buf, 0, size); return(1); }
+    for (uint16_t i = _fontFirst; i < c; i++) offset += pgm_read_byte(_fontData + offset) + 1;
+    size = min(size, pgm_read_byte(_fontData + offset));
+    for (uint8_t i = 0; i < size; i++) buf[i] = pgm_read_byte(_fontData + offset + 1 + i);
+    return(size);
+  }
+
+  // Host simulation instrumentation
+  uint32_t setColumnCalls = 0;  ///< setColumn() calls
+  uint32_t getColumnCalls = 0;  ///< getColumn() calls
+  uint32_t getCharCalls = 0;    ///< getChar() calls
+  uint32_t setFontCalls = 0;    ///< setFont() calls
+  uint32_t spiTransfers = 0;    ///< register writes clocked through the chain
+  uint32_t spiBytes = 0;        ///< bytes clocked through the chain
+
+  void resetCounters(void) { setColumnCalls = getColumnCalls = getCharCalls = setFontCalls = spiTransfers = spiBytes = 0; }
+  const uint8_t *frameBuffer(void) { return(_col); }
+
+  void printFrame(FILE *f)
+  // Print the display as text, column 0 is on the right as on the modules
+  {
+    for (uint8_t r = 0; r < ROW_SIZE; r++)
+    {
+      for (int16_t c = getColumnCount() - 1; c >= 0; c--)
+        fputc(_col[c] & (1 << r) ? '#' : '.', f);
+      fputc('\n', f);
+    }
+  }
+
+  static fontType_t *sysFont(void)
+  {
+    static uint8_t f[5 + 256 * 6];
+
+    if (f[0] != 'F')
+    {
+      uint16_t o = 5;
+
+      f[0] = 'F'; f[1] = 1; f[2] = 0; f[3] = 255; f[4] = 8;
+      for (uint16_t c = 0; c < 256; c++)
+      {
+        uint8_t w = (c < ' ') ? 0 : (c == ' ' ? 2 : 1 + (c % 5));
+
+        f[o++] = w;
+        for (uint8_t i = 0; i < w; i++) f[o++] = (uint8_t)((c * 37 + i * 11) | 0x81);
+      }
+    }
+    return(f);
+  }
+
+private:
+  uint8_t   _numDevices;
+  uint8_t   *_col = nullptr;      // column data for the whole display
+  uint8_t   *_changed = nullptr;  // bit per row for each device, set if the row needs to be sent
+  bool      _autoUpdate = true;
+  bool      _wrapAround = false;
+
+  fontType_t *_fontData = nullptr;
+  uint16_t  _fontFirst = 0, _fontLast = 255;
+  uint32_t  _fontOffset = 0;
+  uint8_t   _fontHeight = 8, _fontMaxWidth = 0;
+
+  void put(uint16_t c, uint8_t value) { _changed[c / COL_SIZE] = 0xff; _col[c] = value; }
+  void autoUpdate(void) { if (_autoUpdate) flush(); }
+
+  void flush(void) { flush(0, _numDevices - 1); }
+  void flush(uint8_t startDev, uint8_t endDev)
+  // Each changed row is one register write clocked through the whole chain
+  {
+    for (uint8_t r = 0; r < ROW_SIZE; r++)
+    {
+      bool b = false;
+
+      for (uint8_t d = startDev; d <= endDev; d++)
+        if (_changed[d] & (1 << r)) { b = true; _changed[d] &= ~(1 << r); }
+      if (b) { spiTransfers++; spiBytes += 2 * _numDevices; }
+    }
+  }
+
+  void loadFontInfo(void)
+  {
+    uint32_t offset;
+
+    _fontFirst = 0; _fontLast = 255; _fontOffset = 0; _fontHeight = 8;
+    if (pgm_read_byte(_fontData) == 'F')
+    {
+      if (pgm_read_byte(_fontData + 1) == 1)
+      {
+        _fontFirst = pgm_read_byte(_fontData + 2);
+        _fontLast = pgm_read_byte(_fontData + 3);
+        _fontHeight = pgm_read_byte(_fontData + 4);
+        _fontOffset = 5;
+      }
+      else if (pgm_read_byte(_fontData + 1) == 2)
+      {
+        _fontFirst = (pgm_read_byte(_fontData + 2) << 8) | pgm_read_byte(_fontData + 3);
+        _fontLast = (pgm_read_byte(_fontData + 4) << 8) | pgm_read_byte(_fontData + 5);
+        _fontHeight = pgm_read_byte(_fontData + 6);
+        _fontOffset = 7;
+      }
+    }
+
+    _fontMaxWidth = 0;
+    offset = _fontOffset;
+    for (uint32_t i = _fontFirst; i <= _fontLast; i++)
+    {
+      uint8_t w = pgm_read_byte(_fontData + offset);
+
+      if (w > _fontMaxWidth) _fontMaxWidth = w;
+      offset += w + 1;
+    }
+  }
+};
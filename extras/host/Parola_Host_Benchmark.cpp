@@ -0,0 +1,183 @@
+// Host benchmark for the MD_Parola text effects.
+//
+// Runs every text effect, IN and OUT, with and without inversion and
+// PA_FLIP_UD/PA_FLIP_LR, for several message lengths on displays from 1 to
+// 64 modules. One CSV line is printed for each run:
+//
+//  modules    number of modules in the display (one zone)
+//  effect     text effect name
+//  dir        IN or OUT
+//  invert     1 if the display is inverted
+//  flip       none, UD or LR
+//  length     message length in characters
+//  frames     animation frames for the effect
+//  us_frame   host CPU time in microseconds for each frame
+//  set_frame  setColumn() calls for each frame
+//  get_frame  getColumn() calls for each frame
+//  spi_frame  bytes clocked into the display chain for each frame
+//
+// The OUT effect is timed after a PA_PRINT IN effect, so it includes the
+// single PA_PRINT frame.
+//
+// Options:
+//  -a    all display sizes from 1 to 64 modules (default 1, 2, 4, 8, 16, 32, 64)
+//  -m n  only display size n modules
+//  -e n  only textEffect_t value n
+//
+// See README.md for how to compile. Build with -O2 for meaningful timings.
+
+#include <chrono>   // before Arduino.h, which defines min() and max() macros
+#include <MD_Parola.h>
+#include <MD_MAX72xx.h>
+#include <SPI.h>
+
+#define HARDWARE_TYPE MD_MAX72XX::FC16_HW
+#define CS_PIN    10
+#define MAX_FRAMES  100000  // stop runaway animations
+
+struct effectDef_t
+{
+  textEffect_t effect;
+  const char *name;
+};
+
+const effectDef_t effect[] =
+{
+  { PA_PRINT, "PRINT" },
+  { PA_SCROLL_UP, "SCROLL_UP" },
+  { PA_SCROLL_DOWN, "SCROLL_DOWN" },
+  { PA_SCROLL_LEFT, "SCROLL_LEFT" },
+  { PA_SCROLL_RIGHT, "SCROLL_RIGHT" },
+#if ENA_SPRITE
+  { PA_SPRITE, "SPRITE" },
+#endif
+#if ENA_MISC
+  { PA_SLICE, "SLICE" },
+  { PA_MESH, "MESH" },
+  { PA_FADE, "FADE" },
+  { PA_DISSOLVE, "DISSOLVE" },
+  { PA_BLINDS, "BLINDS" },
+  { PA_RANDOM, "RANDOM" },
+#endif
+#if ENA_WIPE
+  { PA_WIPE, "WIPE" },
+  { PA_WIPE_CURSOR, "WIPE_CURSOR" },
+#endif
+#if ENA_SCAN
+  { PA_SCAN_HORIZ, "SCAN_HORIZ" },
+  { PA_SCAN_HORIZX, "SCAN_HORIZX" },
+  { PA_SCAN_VERT, "SCAN_VERT" },
+  { PA_SCAN_VERTX, "SCAN_VERTX" },
+#endif
+#if ENA_OPNCLS
+  { PA_OPENING, "OPENING" },
+  { PA_OPENING_CURSOR, "OPENING_CURSOR" },
+  { PA_CLOSING, "CLOSING" },
+  { PA_CLOSING_CURSOR, "CLOSING_CURSOR" },
+#endif
+#if ENA_SCR_DIA
+  { PA_SCROLL_UP_LEFT, "SCROLL_UP_LEFT" },
+  { PA_SCROLL_UP_RIGHT, "SCROLL_UP_RIGHT" },
+  { PA_SCROLL_DOWN_LEFT, "SCROLL_DOWN_LEFT" },
+  { PA_SCROLL_DOWN_RIGHT, "SCROLL_DOWN_RIGHT" },
+#endif
+#if ENA_GROW
+  { PA_GROW_UP, "GROW_UP" },
+  { PA_GROW_DOWN, "GROW_DOWN" },
+#endif
+};
+
+const char *message[] =
+{
+  "Hi",
+  "Hello World!",
+  "The quick brown fox jumps over the lazy dog 0123456789 ABCDEFGHIJ",
+};
+
+const char *flipName[] = { "none", "UD", "LR" };
+
+#if ENA_SPRITE
+const uint8_t sprite[] = { 0x18, 0x3c, 0x7e, 0xff, 0x18, 0x3c, 0x7e, 0xff };
+#endif
+
+void runEffect(uint8_t modules, const effectDef_t &fx, bool bIn, uint8_t inv, uint8_t flip, const char *msg)
+{
+  MD_Parola P = MD_Parola(HARDWARE_TYPE, CS_PIN, modules);
+  MD_MAX72XX *mx = P.getGraphicObject();
+  uint32_t frames = 0;
+  std::chrono::steady_clock::duration cpu(0);
+
+  P.begin();
+#if ENA_SPRITE
+  P.setSpriteData(sprite, 4, 2, sprite, 4, 2);
+#endif
+  randomSeed(1);
+  P.setInvert(inv);
+  P.setZoneEffect(0, flip == 1, PA_FLIP_UD);
+  P.setZoneEffect(0, flip == 2, PA_FLIP_LR);
+  P.displayText(msg, PA_CENTER, 1, 0, bIn ? fx.effect : PA_PRINT, bIn ? PA_NO_EFFECT : fx.effect);
+  mx->resetCounters();
+
+  while (frames < MAX_FRAMES)
+  {
+    std::chrono::steady_clock::time_point t = std::chrono::steady_clock::now();
+    bool done = P.displayAnimate();
+
+    if (P.isAnimationAdvanced())
+    {
+      cpu += std::chrono::steady_clock::now() - t;
+      frames++;
+    }
+    if (done)
+      break;
+
+    uint32_t wait = P.msUntilNextFrame();
+    delay(wait == 0 || wait == PA_NO_DEADLINE ? 1 : wait);
+  }
+
+  double n = (frames == 0 ? 1 : frames);
+
+  printf("%u,%s,%s,%u,%s,%u,%u,%.3f,%.1f,%.1f,%.1f\n", modules, fx.name, bIn ? "IN" : "OUT",
+    inv, flipName[flip], (unsigned)strlen(msg), frames,
+    std::chrono::duration<double, std::micro>(cpu).count() / n,
+    mx->setColumnCalls / n, mx->getColumnCalls / n, mx->spiBytes / n);
+}
+
+int main(int argc, char *argv[])
+{
+  const uint8_t defaultSize[] = { 1, 2, 4, 8, 16, 32, 64 };
+  bool allSizes = false;
+  int onlySize = -1, onlyEffect = -1;
+
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-a") == 0) allSizes = true;
+    else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) onlySize = atoi(argv[++i]);
+    else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) onlyEffect = atoi(argv[++i]);
+  }
+
+  printf("modules,effect,dir,invert,flip,length,frames,us_frame,set_frame,get_frame,spi_frame\n");
+  for (uint8_t s = 0; s < (allSizes ? 64 : ARRAY_SIZE(defaultSize)); s++)
+  {
+    uint8_t modules = (allSizes ? s + 1 : defaultSize[s]);
+
+    if (onlySize != -1 && modules != onlySize)
+      continue;
+
+    for (const effectDef_t &fx : effect)
+    {
+      if (onlyEffect != -1 && fx.effect != onlyEffect)
+        continue;
+
+      for (const char *m : message)
+      for (uint8_t inv = 0; inv < 2; inv++)
+      for (uint8_t flip = 0; flip < 3; flip++)
+      {
+        runEffect(modules, fx, true, inv, flip, m);
+        runEffect(modules, fx, false, inv, flip, m);
+      }
+    }
+  }
+
+  return(0);
+}
@@ -0,0 +1,176 @@
+// Host program to run every MD_Parola text effect on the virtual display.
+//
+// Each effect is run in and out for a few messages, with and without
+// inversion and PA_FLIP_UD/PA_FLIP_LR. One line is printed for each run
+// with the number of animation frames and a hash of all the frames, so the
+// output of two versions of the library can be compared with diff.
+//
+// With ENA_MARKUP, text with markup codes that should display the same as
+// plain text is also run through every effect. These lines end with "same"
+// or "DIFF" from comparing the two runs.
+//
+// Options:
+//  -v  print every frame of the display as text
+//  -c  enable the render cache in all zones
+//  -s  wait for msUntilNextFrame() between calls instead of 1ms
+//
+// See README.md for how to compile.
+
+#include <MD_Parola.h>
+#include <MD_MAX72xx.h>
+#include <SPI.h>
+
+#define HARDWARE_TYPE MD_MAX72XX::FC16_HW
+#define MAX_DEVICES 8
+#define CS_PIN    10
+#define MAX_FRAMES  20000   // stop runaway animations
+
+MD_Parola P = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+
+const textEffect_t effect[] =
+{
+  PA_PRINT, PA_SCROLL_UP, PA_SCROLL_DOWN, PA_SCROLL_LEFT, PA_SCROLL_RIGHT,
+#if ENA_SPRITE
+  PA_SPRITE,
+#endif
+#if ENA_MISC
+  PA_SLICE, PA_MESH, PA_FADE, PA_DISSOLVE, PA_BLINDS, PA_RANDOM,
+#endif
+#if ENA_WIPE
+  PA_WIPE, PA_WIPE_CURSOR,
+#endif
+#if ENA_SCAN
+  PA_SCAN_HORIZ, PA_SCAN_HORIZX, PA_SCAN_VERT, PA_SCAN_VERTX,
+#endif
+#if ENA_OPNCLS
+  PA_OPENING, PA_OPENING_CURSOR, PA_CLOSING, PA_CLOSING_CURSOR,
+#endif
+#if ENA_SCR_DIA
+  PA_SCROLL_UP_LEFT, PA_SCROLL_UP_RIGHT, PA_SCROLL_DOWN_LEFT, PA_SCROLL_DOWN_RIGHT,
+#endif
+#if ENA_GROW
+  PA_GROW_UP, PA_GROW_DOWN,
+#endif
+};
+
+const char *message[] = { "Hi", "Hello World", "A much longer message than fits" };
+
+#if ENA_MARKUP
+// Markup text and the plain text it should display the same as. Markup
+// font 1 is set to the zone font.
+struct markupPair_t
+{
+  const char *plain;
+  const char *markup;
+};
+
+const markupPair_t markupText[] =
+{
+  { "Hello World", "~F1Hello~F0 World" },
+  { "Price ~5", "~S1Price~Sz ~~5" },
+  { "A much longer message than fits", "A much ~F1longer~F0 message ~Uthan fits" },
+};
+#endif
+
+#if ENA_SPRITE
+const uint8_t sprite[] = { 0x18, 0x3c, 0x7e, 0xff, 0x18, 0x3c, 0x7e, 0xff };
+#endif
+
+uint32_t frameHash(void)
+// FNV-1a hash of the display contents
+{
+  const uint8_t *f = P.getGraphicObject()->frameBuffer();
+  uint32_t h = 2166136261UL;
+
+  for (uint16_t i = 0; i < MAX_DEVICES * COL_SIZE; i++)
+    h = (h ^ f[i]) * 16777619UL;
+
+  return(h);
+}
+
+uint32_t runEffect(const char *m, textEffect_t e, bool sleep, bool verbose, uint32_t &frames)
+// Run the effect in and out for the message, return the hash of all the frames
+{
+  MD_MAX72XX *mx = P.getGraphicObject();
+  uint32_t hash = 0;
+
+  frames = 0;
+  randomSeed(1);
+  P.displayClear();
+  P.displayText(m, PA_CENTER, 1, 3, e, e);
+
+  while (!P.displayAnimate() && frames < MAX_FRAMES)
+  {
+    uint32_t wait = sleep ? P.msUntilNextFrame() : 1;
+
+    delay(wait == 0 || wait == PA_NO_DEADLINE ? 1 : wait);
+    if (P.isAnimationAdvanced())
+    {
+      frames++;
+      hash = hash * 31 + frameHash();
+      if (verbose)
+      {
+        printf("\n");
+        mx->printFrame(stdout);
+      }
+    }
+  }
+
+  return(hash);
+}
+
+int main(int argc, char *argv[])
+{
+  bool verbose = false, sleep = false;
+  MD_MAX72XX *mx = P.getGraphicObject();
+
+  P.begin();
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "-v") == 0) verbose = true;
+    else if (strcmp(argv[i], "-c") == 0) P.setRenderCache(true);
+    else if (strcmp(argv[i], "-s") == 0) sleep = true;
+  }
+#if ENA_SPRITE
+  P.setSpriteData(sprite, 4, 2, sprite, 4, 2);
+#endif
+
+  for (uint8_t inv = 0; inv < 2; inv++)
+  for (uint8_t flip = 0; flip < 3; flip++)
+  for (const char *m : message)
+  for (textEffect_t e : effect)
+  {
+    uint32_t hash, frames;
+
+    P.setInvert(inv);
+    P.setZoneEffect(0, flip == 1, PA_FLIP_UD);
+    P.setZoneEffect(0, flip == 2, PA_FLIP_LR);
+    hash = runEffect(m, e, sleep, verbose, frames);
+    printf("%d %d %-2d %-32s %u %08x\n", inv, flip, (int)e, m, frames, hash);
+  }
+
+#if ENA_MARKUP
+  P.setInvert(false);
+  P.setMarkupFont(1, mx->getFont());
+  for (uint8_t flip = 0; flip < 3; flip++)
+  for (const markupPair_t &t : markupText)
+  for (textEffect_t e : effect)
+  {
+    uint32_t hash, frames, markupHash, markupFrames;
+
+    P.setZoneEffect(0, flip == 1, PA_FLIP_UD);
+    P.setZoneEffect(0, flip == 2, PA_FLIP_LR);
+    hash = runEffect(t.plain, e, sleep, verbose, frames);
+    P.setMarkup(true);
+    markupHash = runEffect(t.markup, e, sleep, verbose, markupFrames);
+    P.setMarkup(false);
+    printf("markup %d %-2d %-32s %u %08x %s\n", flip, (int)e, t.plain, markupFrames, markupHash,
+      (hash == markupHash && frames == markupFrames) ? "same" : "DIFF");
+  }
+#endif
+
+  fprintf(stderr, "setColumn=%u getColumn=%u getChar=%u setFont=%u spiBytes=%u\n",
+    mx->setColumnCalls, mx->getColumnCalls, mx->getCharCalls, mx->setFontCalls, mx->spiBytes);
+
+  return(0);
+}
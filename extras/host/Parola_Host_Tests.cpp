@@ -0,0 +1,523 @@
+// Host program with regression tests for the MD_Parola library.
+//
+// Each test prints PASS or FAIL with the line of the first failed check.
+// The program exits with a non-zero status if any test fails.
+//
+// See README.md for how to compile.
+
+#include <MD_Parola.h>
+#include <MD_MAX72xx.h>
+#include <SPI.h>
+
+#define HARDWARE_TYPE MD_MAX72XX::FC16_HW
+#define MAX_DEVICES 8
+#define CS_PIN    10
+#define MAX_FRAMES  20000   // stop runaway animations
+
+MD_Parola P = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+
+static uint16_t failures = 0;
+static bool testOK;
+
+#define CHECK(x) do { if (testOK && !(x)) { printf("FAIL line %d: %s\n", __LINE__, #x); testOK = false; } } while (0)
+
+uint32_t frameHash(void)
+// FNV-1a hash of the display contents
+{
+  const uint8_t *f = P.getGraphicObject()->frameBuffer();
+  uint32_t h = 2166136261UL;
+
+  for (uint16_t i = 0; i < MAX_DEVICES * COL_SIZE; i++)
+    h = (h ^ f[i]) * 16777619UL;
+
+  return(h);
+}
+
+bool runAnimation(MD_Parola &p)
+// Animate until the display finishes, return false if it never does
+{
+  for (uint32_t frames = 0; frames < MAX_FRAMES; frames++)
+  {
+    delay(1);
+    if (p.displayAnimate())
+      return(true);
+  }
+  return(false);
+}
+
+// User defined character glyphs, the first byte is the width in columns
+const uint8_t glyph1[] = { 1, 0xff };
+const uint8_t glyph2[] = { 2, 0xff, 0x81 };
+const uint8_t glyph3[] = { 3, 0xff, 0x81, 0xff };
+
+uint16_t charWidth(uint16_t code)
+// Display width of a one character string, UTF-8 encoded if setUTF8() is on
+{
+  char s[4] = { (char)code, '\0' };
+
+  if (P.getUTF8(0) && code >= 0x800)
+  {
+    s[0] = 0xe0 | (code >> 12);
+    s[1] = 0x80 | ((code >> 6) & 0x3f);
+    s[2] = 0x80 | (code & 0x3f);
+    s[3] = '\0';
+  }
+  else if (P.getUTF8(0) && code >= 0x80)
+  {
+    s[0] = 0xc0 | (code >> 6);
+    s[1] = 0x80 | (code & 0x3f);
+    s[2] = '\0';
+  }
+
+  return(P.getTextColumns(s));
+}
+
+uint16_t userCode(uint16_t n)
+// Distinct character codes for n up to 255 that all share the same hashed
+// table position, and are none of the codes 0, 0xfe or 0xff.
+{
+  return((n << 8) | (n ^ 1));
+}
+
+void testUserCharChurn(void)
+// Add and delete user characters many times over. The table must not
+// fill up with deleted entries and every character must stay reachable.
+// Codes above 0xff are displayed using UTF-8 text.
+{
+  const uint8_t *g[] = { glyph1, glyph2, glyph3 };
+
+  static_assert(USER_CHAR_TABLE <= 256, "userCode() only has 256 codes");
+
+  P.displayClear();
+  P.setUTF8(true);
+
+  // fill the table
+  for (uint16_t c = 0; c < USER_CHAR_TABLE; c++)
+    CHECK(P.addChar(userCode(c), g[c % 3]));
+  CHECK(!P.addChar(0xfe, glyph1));     // full
+
+  // delete and add different codes in the same probe sequence
+  for (uint16_t n = 0; n < 1000; n++)
+  {
+    uint16_t c = (n * 7) % USER_CHAR_TABLE;
+
+    CHECK(P.delChar(0, userCode(c)));
+    CHECK(!P.delChar(0, userCode(c)));
+    CHECK(P.addChar(0xfe, glyph1));
+    CHECK(!P.addChar(0xff, glyph1));   // full again
+    CHECK(charWidth(0xfe) == 1);
+    for (uint16_t i = 0; i < USER_CHAR_TABLE; i++)
+      CHECK(i == c || charWidth(userCode(i)) == (i % 3) + 1u);
+    CHECK(P.delChar(0, 0xfe));
+    CHECK(P.addChar(userCode(c), g[c % 3]));
+  }
+
+  for (uint16_t c = 0; c < USER_CHAR_TABLE; c++)
+    CHECK(P.delChar(0, userCode(c)));
+  for (uint16_t c = 0; c < USER_CHAR_TABLE; c++)
+    CHECK(!P.delChar(0, userCode(c)));
+  CHECK(charWidth(userCode(0)) != 1);
+  P.setUTF8(false);
+}
+
+void testZonePair(void)
+// A follower with wider characters than its lead must still run to the end
+// of its own animation, and zones can only be in one pair.
+{
+  const uint8_t wide[] = { 8, 0xff, 0x81, 0x81, 0x81, 0x81, 0x81, 0x81, 0xff };
+  MD_Parola Z = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+
+  Z.begin(3);
+  Z.setZone(0, 0, 2);
+  Z.setZone(1, 3, 5);
+  Z.setZone(2, 6, 7);
+
+  CHECK(Z.setZonePair(0, 1, 0x80));
+  CHECK(!Z.setZonePair(0, 2, 0x80));  // lead already has a follower
+  CHECK(!Z.setZonePair(2, 1, 0x80));  // follower already in a pair
+  CHECK(!Z.setZonePair(1, 2, 0x80));  // follower cannot lead
+  CHECK(!Z.setZonePair(2, 0, 0x80));  // lead cannot follow
+  CHECK(!Z.setZonePair(0, 0, 0x80));
+
+  for (uint16_t c = 'A'; c <= 'D'; c++)
+    CHECK(Z.addChar(1, c + 0x80, wide));
+
+  Z.displayZoneText(0, "ABCD", PA_LEFT, 1, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+  for (uint32_t frames = 0; frames < MAX_FRAMES && !Z.getZoneStatus(0); frames++)
+  {
+    delay(1);
+    Z.displayAnimate();
+  }
+  CHECK(Z.getZoneStatus(0));
+  CHECK(Z.getZoneStatus(1));
+
+  // the follower scrolled all the way off
+  for (uint16_t c = 3 * COL_SIZE; c < 6 * COL_SIZE; c++)
+    CHECK(Z.getGraphicObject()->getColumn(c) == 0);
+
+  // and starts again with the lead zone
+  Z.displayReset(0);
+  Z.displayAnimate();
+  CHECK(!Z.getZoneStatus(0));
+  CHECK(!Z.getZoneStatus(1));
+
+  // the follower takes its display settings from the lead zone
+  Z.setCharSpacing(0, 3);
+  Z.setInvert(0, true);
+  Z.setZoneEffect(0, true, PA_FLIP_UD);
+  Z.setUTF8(0, true);
+  Z.displayReset(0);
+  delay(1);
+  Z.displayAnimate();
+  CHECK(Z.getCharSpacing(1) == 3);
+  CHECK(Z.getInvert(1));
+  CHECK(Z.getZoneEffect(1, PA_FLIP_UD));
+  CHECK(Z.getUTF8(1));
+
+  Z.clearZonePair(0);
+  CHECK(Z.setZonePair(0, 2, 0x80));
+}
+
+uint32_t finishTime(frameTiming_t ft, uint32_t stallAt, uint32_t stall)
+// Time taken to scroll a message in and out, with one long gap between
+// calls to displayAnimate() after stallAt ms.
+{
+  uint32_t start = millis();
+
+  P.setFrameTiming(ft);
+  P.displayText("Catch up", PA_LEFT, 10, 50, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+  for (uint32_t frames = 0; frames < MAX_FRAMES; frames++)
+  {
+    delay((stall != 0) && (millis() - start == stallAt) ? stall : 1);
+    if (P.displayAnimate())
+      break;
+  }
+  P.setFrameTiming(PA_FRAME_FREE);
+
+  return(millis() - start);
+}
+
+void testFrameCatchup(void)
+// PA_FRAME_CATCHUP runs the frames missed in a stall and finishes on time,
+// PA_FRAME_SKIP finishes later by the skipped frames.
+{
+  uint32_t t = finishTime(PA_FRAME_CATCHUP, 0, 0);
+
+  CHECK(finishTime(PA_FRAME_CATCHUP, 100, 200) <= t + 10);
+  CHECK(finishTime(PA_FRAME_CATCHUP, 100, 2000) <= 100 + 2000 + 50);
+  CHECK(finishTime(PA_FRAME_SKIP, 0, 0) == t);
+  CHECK(finishTime(PA_FRAME_SKIP, 100, 200) >= t + 190);
+}
+
+void testPrint(void)
+// Printed text is held until the end of the line, and characters that do
+// not fit in the buffer are discarded.
+{
+  uint32_t hash;
+
+  P.displayClear();
+  P.displayText("", PA_LEFT, 0, 0, PA_PRINT, PA_NO_EFFECT);
+  runAnimation(P);
+
+  CHECK(P.print("AB") == 2);
+  CHECK(P.print(12) == 2);
+  CHECK(P.getZoneStatus(0));
+  CHECK(P.println() == 2);
+  CHECK(!P.getZoneStatus(0));
+  CHECK(runAnimation(P));
+  hash = frameHash();
+
+  P.displayText("AB12", PA_LEFT, 0, 0, PA_PRINT, PA_NO_EFFECT);
+  CHECK(runAnimation(P));
+  CHECK(frameHash() == hash);
+
+  // fill the buffer past the end
+  static char line[PRINT_BUFFER_SIZE];
+
+  for (uint16_t i = 0; i < PRINT_BUFFER_SIZE - 1; i++)
+  {
+    CHECK(P.write('x') == 1);
+    line[i] = 'x';
+  }
+  CHECK(P.write('y') == 0);
+  P.flush();
+  CHECK(runAnimation(P));
+  hash = frameHash();
+
+  P.displayText(line, PA_LEFT, 0, 0, PA_PRINT, PA_NO_EFFECT);
+  CHECK(runAnimation(P));
+  CHECK(frameHash() == hash);
+}
+
+const char *srcText;    // text for the test text source
+uint16_t srcPos;        // next byte of srcText
+uint16_t srcWait;       // number of times to wait at a '|' in srcText
+uint16_t srcCalls;      // number of times the source was called
+
+int16_t testSource(void)
+// Text source returning srcText, waiting for srcWait calls at each '|'
+{
+  srcCalls++;
+  if (srcText[srcPos] == '|')
+  {
+    if (srcWait != 0)
+    {
+      srcWait--;
+      return(PA_SOURCE_WAIT);
+    }
+    srcPos++;
+  }
+  if (srcText[srcPos] == '\0')
+    return(PA_SOURCE_END);
+
+  return((uint8_t)srcText[srcPos++]);
+}
+
+void startSource(const char *text, uint16_t wait, textEffect_t effect)
+{
+  srcText = text;
+  srcPos = srcCalls = 0;
+  srcWait = wait;
+  P.displayScroll(nullptr, PA_LEFT, effect, 1);
+  P.setTextSource(testSource);
+}
+
+void testTextSource(void)
+// A source waiting for data keeps the animation going until the end of
+// the text, and only a horizontal scroll reads the source.
+{
+  uint32_t frames;
+
+  P.displayClear();
+  startSource("AB|C", 200, PA_SCROLL_LEFT);
+  for (frames = 0; frames < MAX_FRAMES; frames++)
+  {
+    delay(1);
+    if (P.displayAnimate())
+      break;
+    CHECK((srcWait == 0) || (srcPos < 4));
+  }
+  CHECK(frames < MAX_FRAMES);
+  CHECK(srcPos == 4);
+  CHECK(srcCalls > 200);
+
+  // a nul byte also ends the text
+  startSource("AB\0C", 0, PA_SCROLL_LEFT);
+  CHECK(runAnimation(P));
+  CHECK(srcPos == 2);
+
+  // other effects must not read the source
+  startSource("ABC", 0, PA_PRINT);
+  CHECK(runAnimation(P));
+  CHECK(srcCalls == 0);
+
+  startSource("ABC", 0, PA_SCROLL_RIGHT);
+  CHECK(runAnimation(P));
+  CHECK(srcCalls == 0);
+
+  // mirrored scroll right reads the text forward
+  P.setZoneEffect(0, true, PA_FLIP_LR);
+  startSource("ABC", 0, PA_SCROLL_RIGHT);
+  CHECK(runAnimation(P));
+  CHECK(srcPos == 3);
+  P.setZoneEffect(0, false, PA_FLIP_LR);
+
+  P.setTextBuffer("");
+}
+
+const char flashMsg[] PROGMEM = "Flash";
+
+void testFlashText(void)
+// PROGMEM text from displayText() and playlists shows the same as RAM text
+{
+  uint32_t hash;
+  playlistEntry_t list[] =
+  {
+    { flashMsg, PA_LEFT, 1, 0, PA_PRINT, PA_NO_EFFECT, 1, true, true },
+  };
+
+  P.displayClear();
+  P.displayText("Flash", PA_LEFT, 1, 0, PA_PRINT, PA_NO_EFFECT);
+  CHECK(runAnimation(P));
+  hash = frameHash();
+
+  P.displayClear();
+  P.displayText(F("Flash"), PA_LEFT, 1, 0, PA_PRINT, PA_NO_EFFECT);
+  CHECK(runAnimation(P));
+  CHECK(frameHash() == hash);
+  CHECK(P.getTextColumns(F("Flash")) == P.getTextColumns("Flash"));
+
+  P.displayClear();
+  P.setPlaylist(0, list, ARRAY_SIZE(list));
+  for (uint16_t i = 0; i < 10; i++)
+  {
+    delay(1);
+    P.displayAnimate();
+  }
+  CHECK(frameHash() == hash);
+  P.clearPlaylist(0);
+}
+
+#if ENA_MARKUP
+void testMarkupWidth(void)
+// The width of the zone text is measured with its own markup runs, and
+// is not mixed up with the width of the same text without markup.
+{
+  static char textA[] = "~F1Hello~F0 World~S3 again";
+  static char textB[] = "x";
+  static char textC[] = "ab~F0c";
+
+  P.displayClear();
+  P.setMarkupFont(1, P.getGraphicObject()->getFont());
+  P.setMarkup(true);
+
+  // runs left from a longer text
+  P.displayText(textA, PA_LEFT, 1, 0, PA_PRINT, PA_NO_EFFECT);
+  CHECK(runAnimation(P));
+  P.displayText(textB, PA_LEFT, 1, 0, PA_PRINT, PA_NO_EFFECT);
+  CHECK(P.getTextColumns(textB) == P.getTextColumns(0, F("x")));
+  CHECK(runAnimation(P));
+
+  // width measured before the text is displayed with markup
+  P.setMarkup(false);
+  CHECK(P.getTextColumns(textC) > P.getTextColumns("abc"));
+  P.setMarkup(true);
+  P.displayText(textC, PA_LEFT, 1, 0, PA_PRINT, PA_NO_EFFECT);
+  CHECK(P.getTextColumns(textC) == P.getTextColumns("abc"));
+  CHECK(runAnimation(P));
+  CHECK(runAnimation(P));
+
+  P.setMarkup(false);
+  P.setMarkupFont(1, nullptr);
+}
+
+void testMarkupFontSwitch(void)
+// Changing font between runs must not reload the font
+{
+  MD_MAX72XX *mx = P.getGraphicObject();
+  static char text[] = "~F1a~F0b~F1c~F0d~F1e~F0f";
+
+  P.displayClear();
+  P.setMarkupFont(1, mx->getFont());
+  P.setMarkup(true);
+
+  uint32_t calls = mx->setFontCalls;
+
+#if ENA_WIPE
+  P.displayText(text, PA_CENTER, 1, 0, PA_WIPE, PA_WIPE);
+#else
+  P.displayText(text, PA_CENTER, 1, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+#endif
+  CHECK(runAnimation(P));
+  CHECK(mx->setFontCalls == calls);
+
+  P.setMarkup(false);
+  P.setMarkupFont(1, nullptr);
+}
+
+void testMarkupRunsKept(void)
+// Measuring the zone text during an animation must not change the runs
+// or the font the animation is using.
+{
+  static MD_MAX72XX::fontType_t wide[] =
+  {
+    'F', 1, 'a', 'c', 8,
+    5, 0x7f, 0x41, 0x41, 0x41, 0x7f,  // a
+    5, 0x7f, 0x49, 0x49, 0x49, 0x36,  // b
+    5, 0x3e, 0x41, 0x41, 0x41, 0x22,  // c
+  };
+  static char text[] = "~F1abcabc~F0 abc ~F1cba~S3 cab";
+  uint32_t hash[2] = { 0, 0 };
+
+  P.setMarkupFont(1, wide);
+  P.setMarkup(true);
+
+  for (uint8_t pass = 0; pass < 2; pass++)
+  {
+    uint32_t frames = 0;
+
+    P.displayClear();
+    P.displayText(text, PA_LEFT, 1, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+    while (!P.displayAnimate() && frames++ < MAX_FRAMES)
+    {
+      delay(1);
+      hash[pass] = hash[pass] * 31 + frameHash();
+      if (pass == 1)
+      {
+        // a different text in between so the zone text is measured again
+        P.getTextColumns("x");
+        P.getTextColumns(text);
+      }
+    }
+    CHECK(frames < MAX_FRAMES);
+  }
+  CHECK(hash[0] == hash[1]);
+
+  P.setMarkup(false);
+  P.setMarkupFont(1, nullptr);
+}
+
+void testMarkupRunLimit(void)
+// Text after the last run that fits is displayed as it is, not dropped
+{
+  const uint16_t reps = MARKUP_RUNS;
+  const uint16_t parsed = (MARKUP_RUNS - 3) / 2 + 1;  // each "a~~" is two runs
+  static char text[3 * MARKUP_RUNS + 1];
+  static char plain[3 * MARKUP_RUNS + 1];
+  char *p = plain;
+
+  for (uint16_t i = 0; i < reps; i++)
+  {
+    memcpy(text + 3 * i, "a~~", 3);
+    memcpy(p, "a~~", 3);
+    p += (i < parsed ? 2 : 3);
+  }
+  text[3 * reps] = '\0';
+  *p = '\0';
+
+  P.displayClear();
+  P.setMarkup(true);
+  P.displayText(text, PA_LEFT, 1, 0, PA_PRINT, PA_NO_EFFECT);
+  CHECK(P.getTextColumns(text) == P.getTextColumns(plain));
+  CHECK(runAnimation(P));
+  P.setMarkup(false);
+}
+#endif
+
+struct test_t
+{
+  const char *name;
+  void (*fn)(void);
+};
+
+const test_t test[] =
+{
+  { "userCharChurn", testUserCharChurn },
+  { "zonePair", testZonePair },
+  { "frameCatchup", testFrameCatchup },
+  { "print", testPrint },
+  { "textSource", testTextSource },
+  { "flashText", testFlashText },
+#if ENA_MARKUP
+  { "markupWidth", testMarkupWidth },
+  { "markupFontSwitch", testMarkupFontSwitch },
+  { "markupRunsKept", testMarkupRunsKept },
+  { "markupRunLimit", testMarkupRunLimit },
+#endif
+};
+
+int main(int argc, char *argv[])
+{
+  P.begin();
+
+  for (const test_t &t : test)
+  {
+    testOK = true;
+    P.displayReset();
+    t.fn();
+    printf("%-24s %s\n", t.name, testOK ? "PASS" : "FAIL");
+    if (!testOK) failures++;
+  }
+
+  return(failures == 0 ? 0 : 1);
+}
@@ -0,0 +1,9 @@
+/*
+Host build shim for the Arduino SPI library. The virtual MD_MAX72XX does
+not use SPI, the class only exists so that the constructors compile.
+*/
+#pragma once
+
+class SPIClass {};
+
+extern SPIClass SPI;
@@ -0,0 +1,9 @@
+/*
+Host build shim global objects. Compile and link this file together with
+the library source in src/ and the host program.
+*/
+#include <Arduino.h>
+#include <SPI.h>
+
+HardwareSerial Serial;
+SPIClass SPI;
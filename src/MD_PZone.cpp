@@ -29,44 +29,182 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
 
 MD_PZone::MD_PZone(void) :
   _MX(nullptr), _suspend(false), _lastRunTime(0),
-  _fsmState(END), _scrollDistance(0), _zoneEffect(0), 
-  _intensity(DEFAULT_INTENSITY), _zoneStart(0), _zoneEnd(0),
-  _pText(nullptr), 
-  _userChars(nullptr), _cBufSize(0), _cBuf(nullptr), _charSpacing(1), 
-  _fontDef(nullptr)
+  _fsmState(END), _moveIn(true), _scrollDistance(0), _zoneEffect(0),
+  _intensity(DEFAULT_INTENSITY), _pairZone(nullptr), _pairFollower(false), _charOffset(0),
+  _frameTiming(PA_FRAME_FREE),
+  _playlist(nullptr), _playlistSize(0), _playlistIdx(0), _playlistRepeat(0),
+  _printBuf(nullptr), _printLen(0),
+  _zoneStart(0), _zoneEnd(0),
+  _pText(nullptr), _pTextEnd(nullptr), _textReverse(false), _textFlash(false), _utf8(false), _textSource(nullptr), _streamLen(0), _streamEnd(false),
+  _userChars(nullptr), _userCharCount(0), _cBufSize(0), _cBuf(nullptr), _charSpacing(1), 
+  _fontDef(nullptr), _font(&_zoneFont),
+  _renderCache(false), _renderValid(false), _renderReverse(false), _renderSize(0), _renderBuf(nullptr),
+  _widthValid(false), _widthMarkup(false), _widthHits(0), _widthMisses(0)
 #if ENA_SPRITE
   , _spriteInData(nullptr), _spriteOutData(nullptr)
 #endif
 {
+  memset(_userEffect, 0, sizeof(_userEffect));
+  _effectLookup = nullptr;
+#if ENA_ZONE_STATS
+  _statCycleStart = 0;
+  resetStats();
+#endif
+#if ENA_MARKUP
+  _markup = false;
+  _runs = nullptr;
+  _runAlloc = _runCount = _runIdx = _runSpacingMax = 0;
+  _runHash = 0;
+  memset(_markupFont, 0, sizeof(_markupFont));
+#endif
 };
 
 MD_PZone::~MD_PZone(void)
 {
   // release the memory for user defined characters
-  charDef_t *p = _userChars;
-
-  while (p != nullptr)
-  {
-    charDef_t *pt = p;
-    p = pt->next;
-    delete pt;
-  };
+  delete[] _userChars;
 
   // release memory for the character buffer
   delete[] _cBuf;
+
+  // release memory for the render cache
+  delete[] _renderBuf;
+
+  // release memory for the print buffers
+  delete[] _printBuf;
+
+#if ENA_MARKUP
+  // release memory for the markup text runs and fonts
+  delete[] _runs;
+  for (uint8_t i = 0; i < MARKUP_FONTS; i++)
+    delete _markupFont[i];
+#endif
 }
 
-bool MD_PZone::begin(MD_MAX72XX *p)
+bool MD_PZone::begin(MD_MAX72XX *p, effectLookup_t effects)
 {
   _MX = p;
+  _effectLookup = effects;
+  loadFont(&_zoneFont, _fontDef);
   allocateFontBuffer();
   
   return(_cBuf != nullptr);
 }
 
+void MD_PZone::loadFont(fontInfo_t *fi, MD_MAX72XX::fontType_t *fontDef)
+// Resolve a font for this zone once. The header is parsed, the widest
+// character found and an index of every step'th character offset
+// built so that characters can be read without changing the MD_MAX72XX
+// font or walking the font table from the start.
+{
+  uint32_t offset = 0;
+
+  PRINTS("\nloadFont");
+  if (fontDef == nullptr)
+  {
+    _MX->setFont(nullptr);    // resolve the default font
+    fi->data = _MX->getFont();
+  }
+  else
+    fi->data = fontDef;
+
+  // default for fonts without a header
+  fi->first = 0;
+  fi->last = 0xff;
+  fi->maxWidth = 0;
+
+  if (pgm_read_byte(fi->data) == 'F')
+  {
+    switch (pgm_read_byte(fi->data + 1))
+    {
+    case 1:
+      fi->first = pgm_read_byte(fi->data + 2);
+      fi->last = pgm_read_byte(fi->data + 3);
+      offset = 5;
+      break;
+
+    case 2:
+      fi->first = (pgm_read_byte(fi->data + 2) << 8) | pgm_read_byte(fi->data + 3);
+      fi->last = (pgm_read_byte(fi->data + 4) << 8) | pgm_read_byte(fi->data + 5);
+      offset = 7;
+      break;
+    }
+  }
+  PRINT(" first ", fi->first);
+  PRINT(" last ", fi->last);
+
+  // build the index and find the widest character in one pass
+  fi->step = ((fi->last - fi->first) / FONT_INDEX_SIZE) + 1;
+  for (uint32_t i = 0; i <= (uint32_t)(fi->last - fi->first); i++)
+  {
+    uint8_t w = pgm_read_byte(fi->data + offset);
+
+    if (i % fi->step == 0)
+    {
+      if (offset > 0xffff)    // index entries are 16 bit, drop the characters past this point
+      {
+        PRINT(" font truncated at ", fi->first + i);
+        fi->last = fi->first + i - 1;
+        break;
+      }
+      fi->index[i / fi->step] = offset;
+    }
+    if (w > fi->maxWidth)
+      fi->maxWidth = w;
+    offset += w + 1;
+  }
+  PRINT(" step ", fi->step);
+  PRINT(" max width ", fi->maxWidth);
+}
+
+uint8_t MD_PZone::getFontChar(uint16_t code, uint8_t size, uint8_t *cBuf)
+// Load a character from the current font into the buffer.
+// Characters not in the font are returned as one blank column.
+// Only the width is returned if cBuf is nullptr.
+{
+  uint16_t i;
+  uint32_t offset;
+
+  if (code < _font->first || code > _font->last)
+  {
+    if (cBuf != nullptr) memset(cBuf, 0, size);
+    return(1);
+  }
+
+  // start from the nearest index entry and skip forward to the character
+  i = code - _font->first;
+  offset = _font->index[i / _font->step];
+  for (i = i % _font->step; i > 0; i--)
+    offset += pgm_read_byte(_font->data + offset) + 1;
+
+  size = min(size, pgm_read_byte(_font->data + offset));
+  offset++;   // skip the size byte
+  for (i = 0; (cBuf != nullptr) && (i < size); i++)
+    cBuf[i] = pgm_read_byte(_font->data + offset + i);
+
+  return(size);
+}
+
+void MD_PZone::setZoneFont(MD_MAX72XX::fontType_t *fontDef)
+{
+  _fontDef = fontDef;
+  loadFont(&_zoneFont, _fontDef);
+  _renderValid = false;
+  allocateFontBuffer();
+}
+
 void MD_PZone::allocateFontBuffer(void)
 {
-  uint8_t size = _MX->getMaxFontWidth() + getCharSpacing();
+  uint8_t size = _zoneFont.maxWidth + getCharSpacing();
+#if ENA_MARKUP
+  // big enough for the widest character in any font with the widest spacing
+  uint8_t width = _zoneFont.maxWidth;
+
+  for (uint8_t i = 0; i < MARKUP_FONTS; i++)
+    if ((_markupFont[i] != nullptr) && (_markupFont[i]->maxWidth > width))
+      width = _markupFont[i]->maxWidth;
+  size = width + max(getCharSpacing(), _runSpacingMax);
+#endif
   PRINTS("\nallocateFontBuffer");
   if (size > _cBufSize)
   {
@@ -76,6 +214,20 @@ void MD_PZone::allocateFontBuffer(void)
   }
 }
 
+void MD_PZone::setRenderCache(bool b)
+{
+  _renderCache = b;
+  _renderValid = false;
+
+  // release the memory if we don't need it any more
+  if (!_renderCache)
+  {
+    delete[] _renderBuf;
+    _renderBuf = nullptr;
+    _renderSize = 0;
+  }
+}
+
 void MD_PZone::setZoneEffect(boolean b, zoneEffect_t ze)
 {
   switch (ze)
@@ -83,6 +235,7 @@ void MD_PZone::setZoneEffect(boolean b, zoneEffect_t ze)
   case PA_FLIP_LR: _zoneEffect = (b ? ZE_SET(_zoneEffect, ZE_FLIP_LR_MASK) : ZE_RESET(_zoneEffect, ZE_FLIP_LR_MASK));  break;
   case PA_FLIP_UD: _zoneEffect = (b ? ZE_SET(_zoneEffect, ZE_FLIP_UD_MASK) : ZE_RESET(_zoneEffect, ZE_FLIP_UD_MASK));  break;
   }
+  _renderValid = false;
 
   return;
 }
@@ -115,11 +268,26 @@ void MD_PZone::setInitialConditions(void)
 {
   PRINTS("\nsetInitialConditions");
 
+  // the length of the text from a source is not known, so treat it as being too
+  // wide for the zone and let it run to the end
+  if (_textSource != nullptr)
+  {
+    _limitLeft = ZONE_END_COL(_zoneEnd);
+    _limitRight = ZONE_START_COL(_zoneStart);
+    _textLen = _limitLeft - _limitRight + 1;
+    _limitOverflow = true;
+    _renderValid = false;
+    return;
+  }
+
   if (_pText == nullptr)
     return;
 
   _pCurChar = _pText;
+  _pTextEnd = nullptr;    // text length is worked out again when first needed
+  // with markup, measuring the zone text also splits it into runs
   _limitOverflow = !calcTextLimits(_pText);
+  _renderValid = false;   // text may have been changed in place, limits may have moved
 }
 
 void MD_PZone::setInitialEffectConditions(void)
@@ -132,23 +300,97 @@ void MD_PZone::setInitialEffectConditions(void)
   _posOffset = (_textAlignment == PA_RIGHT ? 1 : -1);
 }
 
-uint16_t MD_PZone::getTextWidth(const uint8_t *p)
+uint16_t MD_PZone::getTextWidth(const uint8_t *p, bool flash)
 // Get the width in columns for the text string passed to the function
 // This is the sum of all the characters and the space between them.
+// The last result is reused if the text and settings are unchanged.
 {
   uint16_t  sum = 0;
   uint16_t  width;
+  uint32_t  hash = 2166136261UL ^ flash;   // FNV-1a, RAM and PROGMEM addresses may be the same
+  uint8_t   c;
+  bool      markup = false;   // markup is only interpreted in the zone text
+  fontInfo_t *f = _font;      // the font used by an animation in progress
+
+  if (!flash)
+  {
+    PRINT("\ngetTextWidth: ", (const char *)p);
+  }
 
-  PRINT("\ngetTextWidth: ", (const char *)p);
+  for (const uint8_t *q = p; (c = textByte(q, flash)) != '\0'; q++)
+    hash = (hash ^ c) * 16777619UL;
+
+#if ENA_MARKUP
+  // the runs are only worked out again if the zone text has changed, as
+  // an animation in progress may be using them
+  markup = _markup && (p == _pText) && (flash == _textFlash);
+  if (markup && (_runCount == 0 || _runHash != hash))
+  {
+    prepareRuns();
+    _runHash = hash;
+  }
+#endif
 
-  while (*p != '\0')
+  // setUTF8() and setCharOffset() clear _widthValid
+  if (_widthValid && _widthText == p && _widthHash == hash &&
+      _widthFont == _zoneFont.data && _widthSpacing == _charSpacing &&
+      _widthMarkup == markup)
   {
-    width = findChar(*p++, _cBufSize, _cBuf);
-    sum += width;
-    if (width != 0 && *p) sum += _charSpacing;  // this char had width, so add inter-character spacing
+    _widthHits++;
+    PRINT("\ngetTextWidth: cached W=", _widthCols);
+    return(_widthCols);
   }
 
+  _widthText = p;
+  _widthHash = hash;
+  _widthFont = _zoneFont.data;
+  _widthSpacing = _charSpacing;
+  _widthMarkup = markup;
+  _widthMisses++;
+
+
+  // the widths are found without loading the character buffer, which
+  // an animation in progress may be using
+#if ENA_MARKUP
+  if (markup)
+  {
+    for (uint8_t i = 0; i < _runCount; i++)
+    {
+      const textRun_t *r = &_runs[i];
+
+      selectFont(r->font);
+      for (p = _pText + r->start; p < _pText + r->end; )
+      {
+        uint8_t n = 1;
+        uint16_t code = (r->flags & RUN_GLYPH ? textByte(p, flash) : decodeChar(p, n, flash));
+
+        p += n;
+        width = findChar(code, _cBufSize, nullptr);
+        sum += width;
+        if (width != 0 && ((p < _pText + r->end) || (i + 1 < _runCount))) sum += runSpacing(r);
+      }
+    }
+  }
+  else
+#endif
+  {
+    _font = &_zoneFont;
+    while (textByte(p, flash) != '\0')
+    {
+      uint8_t n;
+      uint16_t code = decodeChar(p, n, flash);
+
+      p += n;
+      width = findChar(code, _cBufSize, nullptr);
+      sum += width;
+      if (width != 0 && textByte(p, flash)) sum += _charSpacing;  // this char had width, so add inter-character spacing
+    }
+  }
+  _font = f;
+
   PRINT("\ngetTextWidth: W=", sum);
+  _widthCols = sum;
+  _widthValid = true;
 
   return(sum);
 }
@@ -161,7 +403,7 @@ bool MD_PZone::calcTextLimits(const uint8_t *p)
   bool b = true;
   uint16_t displayWidth = ZONE_END_COL(_zoneEnd) - ZONE_START_COL(_zoneStart) + 1;
 
-  _textLen = getTextWidth(p);
+  _textLen = getTextWidth(p, _textFlash);
 
   PRINT("\ncalcTextLimits: disp=", displayWidth);
   PRINT(" text=", _textLen);
@@ -216,113 +458,142 @@ bool MD_PZone::calcTextLimits(const uint8_t *p)
   return (b);
 }
 
+MD_PZone::charDef_t *MD_PZone::findUserChar(uint16_t code)
+// Find the table entry for a user defined character using linear probing
+// from the hashed position. Return nullptr if not found.
+{
+  uint16_t h = hashChar(code);
+
+  if (_userCharCount == 0)
+    return(nullptr);
+
+  for (uint16_t i = 0; i < USER_CHAR_TABLE; i++)
+  {
+    charDef_t *pcd = &_userChars[(h + i) & (USER_CHAR_TABLE - 1)];
+
+    if (pcd->code == 0)     // unused slot ends the search
+      break;
+    if (pcd->code == code)
+      return(pcd);
+  }
+
+  return(nullptr);
+}
+
 bool MD_PZone::addChar(uint16_t code, const uint8_t *data)
-// Add a user defined character to the replacement list
+// Add a user defined character to the replacement table
 {
-  charDef_t *pcd;
+  uint16_t h = hashChar(code);
 
   if (code == 0)
     return(false);
 
   PRINTX("\naddChar 0x", code);
+  _renderValid = _widthValid = false;
 
-  // first see if we have the code in our list
-  pcd = _userChars;
-  while (pcd != nullptr)
+  // allocate the table the first time it is needed
+  if (_userChars == nullptr)
   {
-    if (pcd->code == code)
+    if ((_userChars = new charDef_t[USER_CHAR_TABLE]) == nullptr)
     {
-      pcd->data = data;
-      PRINTS(" found existing in list");
-      return(true);
+      PRINTS(" failed allocating table");
+      return(false);
     }
-    pcd = pcd->next;
+    memset(_userChars, 0, sizeof(charDef_t) * USER_CHAR_TABLE);
   }
 
-  // Now see if we have an empty slot in our list
-  pcd = _userChars;
-  while (pcd != nullptr)
+  // the code is either in the probe sequence before the first unused slot,
+  // or it goes into that slot
+  for (uint16_t i = 0; i < USER_CHAR_TABLE; i++)
   {
+    charDef_t *pcd = &_userChars[(h + i) & (USER_CHAR_TABLE - 1)];
+
+    if (pcd->code == code)
+    {
+      pcd->data = data;
+      PRINTS(" found existing in table");
+      return(true);
+    }
     if (pcd->code == 0)
     {
       pcd->code = code;
       pcd->data = data;
-      PRINTS(" found empty slot");
+      _userCharCount++;
+      PRINTS(" added to table");
       return(true);
     }
-    pcd = pcd->next;
-  }
-
-  // default is to add a new node to the front of the list
-  if ((pcd = new charDef_t) != nullptr)
-  {
-    pcd->code = code;
-    pcd->data = data;
-    pcd->next = _userChars;
-    _userChars = pcd;
-    PRINTS(" added new node");
-  }
-  else
-  {
-    PRINTS(" failed allocating new node");
   }
 
-  return(pcd != nullptr);
+  PRINTS(" table full");
+  return(false);
 }
 
 bool MD_PZone::delChar(uint16_t code)
-// Delete a user defined character from the replacement list
+// Delete a user defined character from the replacement table.
+// The characters after it in the probe sequence are moved back to fill
+// the gap, so there are no deleted slots left to slow down the search
+// or fill up the table.
 {
-  charDef_t *pcd = _userChars;
+  charDef_t *pcd;
 
   if (code == 0)
     return(false);
 
-  // Scan down the linked list
-  while (pcd != nullptr)
+  _renderValid = _widthValid = false;
+
+  if ((pcd = findUserChar(code)) == nullptr)
+    return(false);
+
+  uint16_t gap = pcd - _userChars;
+
+  pcd->code = 0;
+  pcd->data = nullptr;
+  _userCharCount--;
+
+  for (uint16_t i = (gap + 1) & (USER_CHAR_TABLE - 1); _userChars[i].code != 0; i = (i + 1) & (USER_CHAR_TABLE - 1))
   {
-    if (pcd->code == code)
-    {
-      pcd->code = 0;
-      pcd->data = nullptr;
-      break;
-    }
-    pcd = pcd->next;
+    uint16_t home = hashChar(_userChars[i].code);
+
+    // leave the character where it is if its hashed position is after the gap
+    if (((gap < i) && (gap < home) && (home <= i)) ||
+        ((gap > i) && ((gap < home) || (home <= i))))
+      continue;
+
+    _userChars[gap] = _userChars[i];
+    _userChars[i].code = 0;
+    _userChars[i].data = nullptr;
+    gap = i;
   }
 
-  return(pcd != nullptr);
+  return(true);
 }
 
 uint8_t MD_PZone::findChar(uint16_t code, uint8_t size, uint8_t *cBuf)
-// Find a character either in user defined list or from font table
+// Find a character either in user defined table or from font table.
+// Only the width is returned if cBuf is nullptr.
 {
-  charDef_t *pcd = _userChars;
+  charDef_t *pcd;
   uint8_t len;
 
+  code += _charOffset;
   PRINTX("\nfindUserChar 0x", code);
-  // check local list first
-  while (pcd != nullptr)
+  // check user table first
+  if ((pcd = findUserChar(code)) != nullptr)
   {
-    PRINTX(" ", pcd->code);
-    if (pcd->code == code)  // found it
-    {
-      PRINTS(" found character");
-      len = min(size, pcd->data[0]);
-      memcpy(cBuf, &pcd->data[1], len);
-      return(len);
-    }
-    pcd = pcd->next;
+    PRINTS(" found character");
+    len = min(size, pcd->data[0]);
+    if (cBuf != nullptr) memcpy(cBuf, &pcd->data[1], len);
+    return(len);
   }
 
-  // get it from the standard font
+  // get it from the zone font
   PRINTS(" no user char");
-  _MX->setFont(_fontDef);   // change to the font for this zone
-  len = _MX->getChar(code, size, cBuf);
+  len = getFontChar(code, size, cBuf);
 
   return(len);
 }
 
-uint8_t MD_PZone::makeChar(uint16_t c, bool addBlank)
+uint8_t MD_PZone::makeChar(uint16_t c, bool addBlank, uint8_t spacing)
 // Load a character bitmap and add in trailing char spacing blanks
 {
   uint8_t len;
@@ -336,7 +607,7 @@ uint8_t MD_PZone::makeChar(uint16_t c, bool addBlank)
   // Add in the inter char spacing
   if (addBlank && len != 0)
   {
-    for (uint8_t i = 0; i < _charSpacing; i++)
+    for (uint8_t i = 0; i < spacing; i++)
     {
       if (len < _cBufSize)
         _cBuf[len++] = 0;
@@ -376,27 +647,82 @@ void MD_PZone::invertBuf(uint8_t *p, uint8_t size)
   }
 }
 
-void MD_PZone::moveTextPointer(void)
+uint16_t MD_PZone::decodeChar(const uint8_t *p, uint8_t &n, bool flash)
+// Return the character code at p and set n to the number of bytes in
+// the character. A byte that does not start a valid UTF-8 sequence is
+// returned as a character on its own. flash is true if p is in PROGMEM.
+{
+  uint16_t code = textByte(p, flash);
+  uint32_t cp;
+
+  n = 1;
+  if (!_utf8 || code < 0xc0 || code > 0xf4)
+    return(code);
+
+  // work out the length of the sequence from the lead byte
+  uint8_t len = (code < 0xe0 ? 2 : (code < 0xf0 ? 3 : 4));
+
+  cp = code & (0x3f >> (len - 1));
+  for (uint8_t i = 1; i < len; i++)
+  {
+    uint8_t c = textByte(p + i, flash);
+
+    if ((c & 0xc0) != 0x80)    // also stops at the nul terminator
+      return(code);
+    cp = (cp << 6) | (c & 0x3f);
+  }
+
+  n = len;
+  return(cp > 0xffff ? 0xfffd : (uint16_t)cp);
+}
+
+const uint8_t *MD_PZone::prevChar(const uint8_t *p)
+// Step back from p to the start of the previous character. The result is
+// before the start of the text if p is the first character.
+{
+  const uint8_t *q = p - 1;
+
+  if (_utf8 && (p > _pText))
+  {
+    uint8_t n = 0;
+
+    // back over the continuation bytes to the lead byte
+    while ((q > _pText) && ((textByte(q, _textFlash) & 0xc0) == 0x80) && (n < 3))
+    {
+      q--;
+      n++;
+    }
+
+    // not a valid sequence ending at p, so the last byte is a character on its own
+    decodeChar(q, n, _textFlash);
+    if (q + n != p)
+      q = p - 1;
+  }
+
+  return(q);
+}
+
+void MD_PZone::moveTextPointer(uint8_t n)
 // This method works when increment is done AFTER processing the character
 // The _endOfText flag is set as a look ahead (ie, when the last character
 // is still valid)
 // We need to move a pointer forward or back, depending on the way we are
-// travelling through the text buffer.
+// travelling through the text buffer. n is the number of bytes in the
+// current character.
 {
   PRINTS("\nMovePtr");
 
-  if ((!ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) && SFX(PA_SCROLL_RIGHT)) ||
-    (ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) && !SFX(PA_SCROLL_RIGHT)))
+  if (_textReverse)
   {
     PRINTS(" --");
     _endOfText = (_pCurChar == _pText);
-    _pCurChar--;
+    _pCurChar = prevChar(_pCurChar);
   }
   else
   {
     PRINTS(" ++");
-    _pCurChar++;
-    _endOfText = (*_pCurChar == '\0');
+    _pCurChar += n;
+    _endOfText = (textByte(_pCurChar, _textFlash) == '\0');
   }
 
   PRINT(": endOfText ", _endOfText);
@@ -412,26 +738,49 @@ bool MD_PZone::getFirstChar(uint8_t &len)
   PRINT(" ZETEST(UD):", ZE_TEST(_zoneEffect, ZE_FLIP_UD_MASK));
   PRINT(" ZETEST(LR):", ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK));
 
+  if (_textSource != nullptr)
+  {
+    _streamEnd = false;   // read on from where the last animation stopped
+    return(getStreamChar(len));
+  }
+
   // initialise pointers and make sure we have a good string to process
   _pCurChar = _pText;
-  if ((_pCurChar == nullptr) || (*_pCurChar == '\0'))
+  if ((_pCurChar == nullptr) || (textByte(_pCurChar, _textFlash) == '\0'))
   {
     _endOfText = true;
     return(false);
   }
   _endOfText = false;
-  if ((!ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) && (SFX(PA_SCROLL_RIGHT))) ||
-    (ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) && !SFX(PA_SCROLL_RIGHT)))
+
+#if ENA_MARKUP
+  if (_markup)
+  {
+    if (_runCount == 0)
+    {
+      _endOfText = true;
+      return(false);
+    }
+    _runIdx = (_textReverse ? _runCount - 1 : 0);
+    _pCurChar = (_textReverse ? lastRunChar() : _pText + _runs[0].start);
+    return(getRunChar(len));
+  }
+#endif
+  if (_textReverse)
   {
     PRINTS("\nReversed String");
-    _pCurChar += strlen((const char *)_pText) - 1;
+    if (_pTextEnd == nullptr)
+      _pTextEnd = _pText + (_textFlash ? strlen_P((const char *)_pText) : strlen((const char *)_pText));
+    _pCurChar = prevChar(_pTextEnd);
   }
 
   // good string, get the first char into the current buffer
-  len = makeChar(*_pCurChar, *(_pCurChar + 1) != '\0');
+  uint8_t n;
+  uint16_t code = decodeChar(_pCurChar, n, _textFlash);
 
-  if ((!ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) && (SFX(PA_SCROLL_RIGHT))) ||
-    (ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) && !SFX(PA_SCROLL_RIGHT)))
+  len = makeChar(code, textByte(_pCurChar + n, _textFlash) != '\0', _charSpacing);
+
+  if (_textReverse)
   {
     PRINTS("\nReverse Buffer");
     reverseBuf(_cBuf, len);
@@ -443,7 +792,301 @@ bool MD_PZone::getFirstChar(uint8_t &len)
     invertBuf(_cBuf, len);
   }
 
-  moveTextPointer();
+  moveTextPointer(n);
+
+  return(true);
+}
+
+#if ENA_MARKUP
+void MD_PZone::setMarkupFont(uint8_t f, MD_MAX72XX::fontType_t *fontDef)
+// The font is resolved here, so selecting it for a run costs nothing
+{
+  if (f == 0 || f > MARKUP_FONTS)
+    return;
+
+  fontInfo_t *&fi = _markupFont[f - 1];
+
+  if (_font == fi)
+    _font = &_zoneFont;
+
+  if (fontDef == nullptr)
+  {
+    delete fi;
+    fi = nullptr;
+  }
+  else
+  {
+    if (fi == nullptr)
+      fi = new fontInfo_t;
+    if (fi != nullptr)
+    {
+      loadFont(fi, fontDef);
+      allocateFontBuffer();
+    }
+  }
+  _renderValid = false;
+  _widthValid = false;
+}
+
+uint8_t MD_PZone::runSpacing(const textRun_t *r)
+{
+  return(r->spacing == RUN_SPACING_ZONE ? _charSpacing : r->spacing);
+}
+
+void MD_PZone::prepareRuns(void)
+// Split the zone text into runs, making the array bigger if needed
+{
+  uint8_t n = parseRuns(nullptr);
+
+  if (n > _runAlloc)
+  {
+    delete[] _runs;
+    _runs = new textRun_t[n];
+    _runAlloc = (_runs == nullptr ? 0 : n);
+  }
+  _runCount = (n > _runAlloc ? 0 : parseRuns(_runs));
+  if (_runIdx >= _runCount)
+    _runIdx = 0;
+  selectFont(0);
+  allocateFontBuffer();
+}
+
+uint8_t MD_PZone::parseRuns(textRun_t *runs)
+// Split the zone text into runs of characters that are displayed with the
+// same settings, removing the markup codes. The runs are written to the
+// array if runs is not nullptr. Return the number of runs.
+// A markup code can end a run and add a run of its own, so codes are only
+// worked out while there is room for two more runs and the final one. After
+// that the last run continues to the end of the text, codes included.
+{
+  textRun_t cur = { 0, 0, 0, RUN_SPACING_ZONE, 0 };
+  uint16_t  i = 0;
+  uint8_t   count = 0;
+  uint8_t   c;
+
+  _runSpacingMax = 0;
+  while (true)
+  {
+    c = textByte(_pText + i, _textFlash);
+    if ((c != MARKUP_ESCAPE || count > MARKUP_RUNS - 3) && c != '\0')
+    {
+      i++;
+      continue;
+    }
+
+    // close the run before the markup code or the end of the text
+    if (i > cur.start)
+    {
+      cur.end = i;
+      if (runs != nullptr) runs[count] = cur;
+      count++;
+    }
+    if (c == '\0')
+      break;
+
+    // work out the markup code
+    uint8_t cmd = textByte(_pText + i + 1, _textFlash);
+    uint8_t arg = (cmd == '\0' ? '\0' : textByte(_pText + i + 2, _textFlash));
+    bool glyph = false;
+
+    PRINTX("\nparseRuns code ", cmd);
+    i += (cmd == '\0' ? 1 : 2);
+    switch (cmd)
+    {
+    case 'F':   // font
+      if (arg >= '0' && arg <= '0' + MARKUP_FONTS)
+      {
+        cur.font = arg - '0';
+        i++;
+      }
+      break;
+
+    case 'S':   // character spacing
+      if (arg >= '0' && arg <= '9')
+      {
+        cur.spacing = arg - '0';
+        if (cur.spacing > _runSpacingMax) _runSpacingMax = cur.spacing;
+        i++;
+      }
+      else if (arg == 'z')
+      {
+        cur.spacing = RUN_SPACING_ZONE;
+        i++;
+      }
+      break;
+
+    case 'I': cur.flags |= RUN_INVERT;  break;   // invert on
+    case 'i': cur.flags &= ~RUN_INVERT; break;   // invert off
+
+    case 'U':   // the next byte is the character code
+      if (arg != '\0')
+      {
+        glyph = true;
+        i++;
+      }
+      break;
+
+    case MARKUP_ESCAPE:  // the escape character itself
+      glyph = true;
+      break;
+    }
+
+    // characters given by code are a run of one byte on their own
+    if (glyph)
+    {
+      if (runs != nullptr)
+      {
+        runs[count] = cur;
+        runs[count].start = i - 1;
+        runs[count].end = i;
+        runs[count].flags |= RUN_GLYPH;
+      }
+      count++;
+    }
+    cur.start = i;
+  }
+
+  PRINT("\nparseRuns count ", count);
+  return(count);
+}
+
+const uint8_t *MD_PZone::lastRunChar(void)
+// Start of the last character of the current run, used when the text is
+// scanned from the end.
+{
+  const textRun_t *r = &_runs[_runIdx];
+  const uint8_t *p = (r->flags & RUN_GLYPH ? _pText + r->start : prevChar(_pText + r->end));
+
+  return(p < _pText + r->start ? _pText + r->start : p);
+}
+
+bool MD_PZone::getRunChar(uint8_t &len)
+// Load the character at _pCurChar with the settings of the current run into
+// the char buffer, set len to the number of columns, then move on to the
+// next character in the scan direction, which may be in another run.
+// Return false if there are no characters.
+{
+  // the text may have been changed since the runs were worked out
+  if (_endOfText || (_runIdx >= _runCount) || (textByte(_pCurChar, _textFlash) == '\0'))
+  {
+    _endOfText = true;
+    selectFont(0);
+    return(false);
+  }
+
+  const textRun_t *r = &_runs[_runIdx];
+  const uint8_t *pStart = _pText + r->start;
+  const uint8_t *pEnd = _pText + r->end;
+  uint8_t n = 1;
+  uint16_t code;
+
+  selectFont(r->font);
+  code = (r->flags & RUN_GLYPH ? textByte(_pCurChar, _textFlash) : decodeChar(_pCurChar, n, _textFlash));
+
+  len = makeChar(code, (_pCurChar + n < pEnd) || (_runIdx + 1 < _runCount), runSpacing(r));
+
+  if (r->flags & RUN_INVERT)
+  {
+    for (uint8_t i = 0; i < len; i++)
+      _cBuf[i] = ~_cBuf[i];
+  }
+
+  if (_textReverse)
+    reverseBuf(_cBuf, len);
+
+  if ZE_TEST(_zoneEffect, ZE_FLIP_UD_MASK)
+    invertBuf(_cBuf, len);
+
+  // move to the next character
+  if (_textReverse)
+  {
+    if (_pCurChar > pStart)
+    {
+      _pCurChar = prevChar(_pCurChar);
+      if (_pCurChar < pStart) _pCurChar = pStart;
+    }
+    else if (_runIdx == 0)
+      _endOfText = true;
+    else
+    {
+      _runIdx--;
+      _pCurChar = lastRunChar();
+    }
+  }
+  else
+  {
+    _pCurChar += n;
+    if (_pCurChar >= pEnd)
+    {
+      if (_runIdx + 1 < _runCount)
+        _pCurChar = _pText + _runs[++_runIdx].start;
+      else
+        _endOfText = true;
+    }
+  }
+
+  // leave the zone font loaded for anything else that uses it
+  if (_endOfText)
+    selectFont(0);
+
+  return(true);
+}
+#endif
+
+bool MD_PZone::getStreamChar(uint8_t &len)
+// Load the next character from the text source into the char buffer and
+// set len to the number of columns. The lookahead is topped up first so
+// that a whole character is available and we know if another one follows.
+// If the source has nothing yet a blank column is loaded so the animation
+// carries on, and the source is asked again for the next column.
+// Return false at the end of the text.
+{
+  while (!_streamEnd && (_streamLen < STREAM_LOOKAHEAD))
+  {
+    int16_t c = _textSource();
+
+    if ((c == PA_SOURCE_END) || (c == 0))
+      _streamEnd = true;
+    else if (c > 0)
+      _streamBuf[_streamLen++] = (uint8_t)c;
+    else    // nothing available yet
+      break;
+  }
+  _streamBuf[_streamLen] = '\0';
+
+  if ((_streamLen == 0) && _streamEnd)
+  {
+    _endOfText = true;
+    return(false);
+  }
+
+  // wait for the rest of a UTF-8 sequence before decoding it
+  uint8_t need = 1;
+
+  if (_utf8 && (_streamLen != 0) && (_streamBuf[0] >= 0xc0) && (_streamBuf[0] <= 0xf4))
+    need = (_streamBuf[0] < 0xe0 ? 2 : (_streamBuf[0] < 0xf0 ? 3 : 4));
+
+  if ((_streamLen < need) && !_streamEnd)
+  {
+    _cBuf[0] = 0;
+    len = 1;
+    _endOfText = false;
+    return(true);
+  }
+
+  uint8_t n;
+  uint16_t code = decodeChar(_streamBuf, n, false);
+
+  // only the last character of the text has no spacing after it
+  len = makeChar(code, (_streamLen > n) || !_streamEnd, _charSpacing);
+
+  if ZE_TEST(_zoneEffect, ZE_FLIP_UD_MASK)
+    invertBuf(_cBuf, len);
+
+  // drop the character from the lookahead
+  _streamLen -= n;
+  memmove(_streamBuf, _streamBuf + n, _streamLen);
+  _endOfText = (_streamLen == 0) && _streamEnd;
 
   return(true);
 }
@@ -461,10 +1104,20 @@ bool MD_PZone::getNextChar(uint8_t &len)
   if (_endOfText)
     return(false);
 
-  len = makeChar(*_pCurChar, *(_pCurChar + 1) != '\0');
+  if (_textSource != nullptr)
+    return(getStreamChar(len));
 
-  if ((!ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) && (SFX(PA_SCROLL_RIGHT))) ||
-    (ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) && !SFX(PA_SCROLL_RIGHT)))
+#if ENA_MARKUP
+  if (_markup)
+    return(getRunChar(len));
+#endif
+
+  uint8_t n;
+  uint16_t code = decodeChar(_pCurChar, n, _textFlash);
+
+  len = makeChar(code, textByte(_pCurChar + n, _textFlash) != '\0', _charSpacing);
+
+  if (_textReverse)
   {
     PRINTS("\nReversed Buffer");
     reverseBuf(_cBuf, len);
@@ -476,35 +1129,431 @@ bool MD_PZone::getNextChar(uint8_t &len)
     invertBuf(_cBuf, len);
   }
 
-  moveTextPointer();
+  moveTextPointer(n);
 
   return(true);
 }
 
-bool MD_PZone::zoneAnimate(void)
+uint32_t MD_PZone::getFrameWait(uint32_t now)
+// Work out how long before the next frame is due, allowing for
+// frame speed and the pause between IN and OUT animations.
+{
+  if (_suspend || _pairFollower)
+    return(PA_NO_DEADLINE);
+
+  if (_fsmState != END)
+    return(frameWait(now));
+
+  // a follower still running is timed by its lead zone
+  if ((_pairZone != nullptr) && (_pairZone->_fsmState != END))
+    return(_pairZone->frameWait(now));
+
+  return(PA_NO_DEADLINE);
+}
+
+uint32_t MD_PZone::frameWait(uint32_t now)
+// Time before the next frame of a running animation is due
+{
+  uint32_t wait = frameInterval();
+  uint32_t elapsed = now - _lastRunTime;
+
+  return(elapsed >= wait ? 0 : wait - elapsed);
+}
+
+uint16_t MD_PZone::frameInterval(void)
+// The time between the last frame and the next one
+{
+  uint16_t wait = (_moveIn ? _tickTimeIn : _tickTimeOut);
+
+  if ((_fsmState == PAUSE) && (_pauseTime > wait))
+    wait = _pauseTime;
+
+  return(wait);
+}
+
+#if ENA_ZONE_STATS
+void MD_PZone::getStats(zoneStats_t &stats)
+{
+  stats.frames = _statFrames;
+  stats.renderMin = (_statFrames == 0 ? 0 : _statRenderMin);
+  stats.renderMax = _statRenderMax;
+  stats.renderMean = (_statFrames == 0 ? 0 : _statRenderTotal / _statFrames);
+  stats.flushMax = _statFlushMax;
+  stats.flushMean = (_statFrames == 0 ? 0 : _statFlushTotal / _statFrames);
+  stats.cycleTime = _statCycleTime;
+  stats.lateFrames = _statLateFrames;
+  stats.pauseOverrun = _statPauseOverrun;
+}
+
+void MD_PZone::resetStats(void)
 {
-#if TIME_PROFILING
-  static uint32_t  cycleStartTime;
+  _statFrames = 0;
+  _statRenderMin = 0xffffffffUL;
+  _statRenderMax = _statRenderTotal = 0;
+  _statFlushMax = _statFlushTotal = 0;
+  _statCycleTime = 0;
+  _statLateFrames = 0;
+  _statPauseOverrun = 0;
+}
 #endif
+
+// Wrappers to call the library effects through the effect table
+void MD_PZone::fxPrint(MD_PZone *z, bool bIn)       { z->effectPrint(bIn); }
+void MD_PZone::fxScrollUp(MD_PZone *z, bool bIn)    { z->effectVScroll(true, bIn); }
+void MD_PZone::fxScrollDown(MD_PZone *z, bool bIn)  { z->effectVScroll(false, bIn); }
+void MD_PZone::fxScrollLeft(MD_PZone *z, bool bIn)  { z->effectHScroll(true, bIn); }
+void MD_PZone::fxScrollRight(MD_PZone *z, bool bIn) { z->effectHScroll(false, bIn); }
+#if ENA_SPRITE
+void MD_PZone::fxSprite(MD_PZone *z, bool bIn)      { z->effectSprite(bIn, PA_SPRITE); }
+#endif // ENA_SPRITE
+#if ENA_MISC
+void MD_PZone::fxSlice(MD_PZone *z, bool bIn)       { z->effectSlice(bIn); }
+void MD_PZone::fxMesh(MD_PZone *z, bool bIn)        { z->effectMesh(bIn); }
+void MD_PZone::fxFade(MD_PZone *z, bool bIn)        { z->effectFade(bIn); }
+void MD_PZone::fxDissolve(MD_PZone *z, bool bIn)    { z->effectDissolve(bIn); }
+void MD_PZone::fxBlinds(MD_PZone *z, bool bIn)      { z->effectBlinds(bIn); }
+void MD_PZone::fxRandom(MD_PZone *z, bool bIn)      { z->effectRandom(bIn); }
+#endif // ENA_MISC
+#if ENA_WIPE
+void MD_PZone::fxWipe(MD_PZone *z, bool bIn)        { z->effectWipe(false, bIn); }
+void MD_PZone::fxWipeCursor(MD_PZone *z, bool bIn)  { z->effectWipe(true, bIn); }
+#endif // ENA_WIPE
+#if ENA_SCAN
+void MD_PZone::fxScanHoriz(MD_PZone *z, bool bIn)   { z->effectHScan(bIn, false); }
+void MD_PZone::fxScanHorizX(MD_PZone *z, bool bIn)  { z->effectHScan(bIn, true); }
+void MD_PZone::fxScanVert(MD_PZone *z, bool bIn)    { z->effectVScan(bIn, false); }
+void MD_PZone::fxScanVertX(MD_PZone *z, bool bIn)   { z->effectVScan(bIn, true); }
+#endif // ENA_SCAN
+#if ENA_OPNCLS
+void MD_PZone::fxOpening(MD_PZone *z, bool bIn)       { z->effectOpen(false, bIn); }
+void MD_PZone::fxOpeningCursor(MD_PZone *z, bool bIn) { z->effectOpen(true, bIn); }
+void MD_PZone::fxClosing(MD_PZone *z, bool bIn)       { z->effectClose(false, bIn); }
+void MD_PZone::fxClosingCursor(MD_PZone *z, bool bIn) { z->effectClose(true, bIn); }
+#endif // ENA_OPNCLS
+#if ENA_SCR_DIA
+void MD_PZone::fxScrollUpLeft(MD_PZone *z, bool bIn)    { z->effectDiag(true, true, bIn); }
+void MD_PZone::fxScrollUpRight(MD_PZone *z, bool bIn)   { z->effectDiag(true, false, bIn); }
+void MD_PZone::fxScrollDownLeft(MD_PZone *z, bool bIn)  { z->effectDiag(false, true, bIn); }
+void MD_PZone::fxScrollDownRight(MD_PZone *z, bool bIn) { z->effectDiag(false, false, bIn); }
+#endif // ENA_SCR_DIA
+#if ENA_GROW
+void MD_PZone::fxGrowUp(MD_PZone *z, bool bIn)      { z->effectGrow(true, bIn); }
+void MD_PZone::fxGrowDown(MD_PZone *z, bool bIn)    { z->effectGrow(false, bIn); }
+#endif // ENA_GROW
+
+// Library effects, in the same order as textEffect_t
+const effectFunc_t MD_PZone::_effectTable[] PROGMEM =
+{
+  nullptr,        // PA_NO_EFFECT
+  fxPrint,
+  fxScrollUp,
+  fxScrollDown,
+  fxScrollLeft,
+  fxScrollRight,
+#if ENA_SPRITE
+  fxSprite,
+#endif
+#if ENA_MISC
+  fxSlice,
+  fxMesh,
+  fxFade,
+  fxDissolve,
+  fxBlinds,
+  fxRandom,
+#endif
+#if ENA_WIPE
+  fxWipe,
+  fxWipeCursor,
+#endif
+#if ENA_SCAN
+  fxScanHoriz,
+  fxScanHorizX,
+  fxScanVert,
+  fxScanVertX,
+#endif
+#if ENA_OPNCLS
+  fxOpening,
+  fxOpeningCursor,
+  fxClosing,
+  fxClosingCursor,
+#endif
+#if ENA_SCR_DIA
+  fxScrollUpLeft,
+  fxScrollUpRight,
+  fxScrollDownLeft,
+  fxScrollDownRight,
+#endif
+#if ENA_GROW
+  fxGrowUp,
+  fxGrowDown,
+#endif
+};
+
+effectFunc_t MD_PZone::getEffect(textEffect_t id)
+// Return the function for the effect, nullptr if there is none
+{
+  if (id >= PA_USER_1)
+    return(id < PA_USER_1 + USER_EFFECTS ? _userEffect[id - PA_USER_1] : nullptr);
+
+  return(_effectLookup != nullptr ? _effectLookup(id) : nullptr);
+}
+
+effectFunc_t MD_PZone::allEffects(textEffect_t id)
+{
+  return(id < ARRAY_SIZE(_effectTable) ? (effectFunc_t)pgm_read_ptr(&_effectTable[id]) : nullptr);
+}
+
+bool MD_PZone::setUserEffect(textEffect_t id, effectFunc_t fn)
+{
+  if (id < PA_USER_1 || id >= PA_USER_1 + USER_EFFECTS)
+    return(false);
+
+  _userEffect[id - PA_USER_1] = fn;
+  return(true);
+}
+
+void MD_PZone::setPairZone(MD_PZone *z, uint8_t offset)
+{
+  if (_pairZone != nullptr)
+  {
+    _pairZone->_pairFollower = false;
+    _pairZone->setCharOffset(0);
+  }
+
+  _pairZone = z;
+  if (_pairZone != nullptr)
+  {
+    _pairZone->_pairFollower = true;
+    _pairZone->setCharOffset(offset);
+    _pairZone->_fsmState = END;   // wait for the lead zone to start a new animation
+  }
+}
+
+void MD_PZone::copyToPair(void)
+// The follower runs the same text with the same animation, timing and
+// display settings, so both halves have the same width and stay in step
+{
+  MD_PZone *z = _pairZone;
+
+  z->setTextBuffer((const char *)_pText);
+  z->_textFlash = _textFlash;
+  if (z->_utf8 != _utf8)
+    z->setUTF8(_utf8);
+  if (z->_charSpacing != _charSpacing)
+    z->setCharSpacing(_charSpacing);
+  if (z->_zoneEffect != _zoneEffect)
+  {
+    z->_zoneEffect = _zoneEffect;
+    z->_renderValid = false;
+  }
+  z->_inverted = _inverted;
+  z->_scrollDistance = _scrollDistance;
+#if ENA_MARKUP
+  if (z->_markup != _markup)
+    z->setMarkup(_markup);
+#endif
+  z->setTextAlignment(_textAlignment);
+  z->_effectIn = _effectIn;
+  z->_effectOut = _effectOut;
+  z->_tickTimeIn = _tickTimeIn;
+  z->_tickTimeOut = _tickTimeOut;
+  z->_pauseTime = _pauseTime;
+  z->_frameTiming = _frameTiming;
+  z->_fsmState = INITIALISE;
+}
+
+void MD_PZone::setPlaylist(playlistEntry_t *list, uint8_t size)
+{
+  _playlist = (size == 0 ? nullptr : list);
+  _playlistSize = (_playlist == nullptr ? 0 : size);
+  _playlistIdx = (_playlistSize == 0 ? 0 : _playlistSize - 1);   // so the first entry is next
+  _playlistRepeat = 0;
+
+  if (_playlist != nullptr && !nextPlaylistEntry())
+    _fsmState = END;
+}
+
+bool MD_PZone::nextPlaylistEntry(void)
+// Start the next enabled entry in the playlist, or show the current entry
+// again if it has repeats left. Return false if no entry is enabled.
+{
+  if (_playlistRepeat > 1 && _playlist[_playlistIdx].enabled)
+  {
+    _playlistRepeat--;
+    zoneReset();
+    return(true);
+  }
+
+  for (uint8_t i = 0; i < _playlistSize; i++)
+  {
+    if (++_playlistIdx >= _playlistSize)
+      _playlistIdx = 0;
+
+    const playlistEntry_t *p = &_playlist[_playlistIdx];
+
+    if (p->enabled)
+    {
+      PRINT("\nPlaylist entry ", _playlistIdx);
+      if (p->flash)
+        setTextBuffer((const __FlashStringHelper *)p->pText);
+      else
+        setTextBuffer(p->pText);
+      setTextAlignment(p->align);
+      setSpeed(p->speed);
+      setPause(p->pause);
+      setTextEffect(p->effectIn, p->effectOut);
+      _playlistRepeat = p->repeat;
+      zoneReset();
+      return(true);
+    }
+  }
+
+  return(false);
+}
+
+bool MD_PZone::allocatePrintBuffer(void)
+{
+  if (_printBuf == nullptr)
+  {
+    if ((_printBuf = new char[2 * PRINT_BUFFER_SIZE]) == nullptr)
+    {
+      PRINTS("\nPrint buffer allocation failed");
+      return(false);
+    }
+    _printBuf[PRINT_BUFFER_SIZE] = '\0';
+    _printLen = 0;
+  }
+
+  return(true);
+}
+
+bool MD_PZone::printChar(uint8_t c)
+{
+  if (!allocatePrintBuffer() || (_printLen >= PRINT_BUFFER_SIZE - 1))
+    return(false);
+
+  _printBuf[_printLen++] = c;
+  return(true);
+}
+
+const char *MD_PZone::printLine(void)
+// The text is copied so that printing the next line does not change
+// the text being displayed.
+{
+  char *pText;
+
+  if (!allocatePrintBuffer())
+    return(nullptr);
+
+  pText = _printBuf + PRINT_BUFFER_SIZE;
+  memcpy(pText, _printBuf, _printLen);
+  pText[_printLen] = '\0';
+  _printLen = 0;
+
+  return(pText);
+}
+
+bool MD_PZone::zoneAnimate(uint32_t now)
+{
+  // a follower zone is animated, and its completion reported, by its lead zone
+  if (_pairFollower)
+    return(false);
+
   _animationAdvanced = false;   // assume this will not happen this time around
+  if (_pairZone != nullptr)
+    _pairZone->_animationAdvanced = false;
 
-  if (_fsmState == END)
+  if (getStatus())
     return(true);
 
   // work through things that stop us running this at all
-  uint32_t tickTime = (_moveIn ? _tickTimeIn : _tickTimeOut);
-  if (((_fsmState == PAUSE) && (millis() - _lastRunTime < _pauseTime)) ||
-    (millis() - _lastRunTime < tickTime) ||
-    (_suspend))
+  if (getFrameWait(now) != 0)
     return(false);
 
-  // save the time now, before we run the animation, so that the animation is part of the
-  // delay between animations giving more accurate frame timing.
-  _lastRunTime = millis();
+  // Catching up runs frames until the next one is not yet due
+  uint8_t frames = (_frameTiming == PA_FRAME_CATCHUP ? FRAME_CATCHUP_MAX : 1);
+
+  do
+  {
+    if (_fsmState != END)
+    {
+#if ENA_ZONE_STATS
+      // check the frame timing before _lastRunTime is updated. The first frame of
+      // the animation follows an arbitrary gap so it is not counted.
+      if (_fsmState == PAUSE)
+        _statPauseOverrun += (now - _lastRunTime) - max((uint32_t)_pauseTime, (uint32_t)(_moveIn ? _tickTimeIn : _tickTimeOut));
+      else if ((_fsmState != INITIALISE) && (now - _lastRunTime > (_moveIn ? _tickTimeIn : _tickTimeOut)))
+        _statLateFrames++;
+#endif
+
+      // save the time before we run the animation, so that the animation is part of the
+      // delay between animations giving more accurate frame timing.
+      advanceClock(now);
+
+      // the follower starts whenever this zone does, so the two never drift apart
+      if ((_pairZone != nullptr) && (_fsmState == INITIALISE))
+        copyToPair();
+
+      animateFrame(now);
+      if ((_pairZone != nullptr) && (_pairZone->_fsmState != END))
+      {
+        _pairZone->_lastRunTime = _lastRunTime;
+        _pairZone->animateFrame(now);
+      }
+    }
+    else
+    {
+      // this zone finished first, run the follower on to the end of its own animation
+      _pairZone->advanceClock(now);
+      _pairZone->animateFrame(now);
+    }
+
+    // start the next message straight away, without waiting for the application
+    if (getStatus() && (_playlist != nullptr))
+      nextPlaylistEntry();
+  } while ((--frames != 0) && (frameInterval() != 0) && (getFrameWait(now) == 0));
+
+  // any frames still late are run by the next calls, so none are lost
+  return(getStatus());
+}
+
+void MD_PZone::advanceClock(uint32_t now)
+// Set the time base for the frame about to run. Free running frames are timed
+// from now. Fixed timestep frames are timed from when the frame was due, so the
+// time base does not move with the time animate is called.
+{
+  uint16_t wait = frameInterval();
+
+  if ((_frameTiming == PA_FRAME_FREE) || (_fsmState == INITIALISE) || (wait == 0))
+  {
+    _lastRunTime = now;
+    return;
+  }
+
+  _lastRunTime += wait;
+  if (_frameTiming == PA_FRAME_SKIP)
+    skipFrames(now);
+}
+
+void MD_PZone::skipFrames(uint32_t now)
+// Move the time base on by whole frames so that the next frame is not yet due
+{
+  uint16_t wait = frameInterval();
+
+  if (wait != 0)
+    _lastRunTime += ((now - _lastRunTime) / wait) * wait;
+}
+
+void MD_PZone::animateFrame(uint32_t now)
+{
+#if ENA_ZONE_STATS
+  uint32_t renderStart = micros();
+#endif
+
   _animationAdvanced = true;    // we now know it will happen!
 
   // any text to display?
-  if (_pText != nullptr)
+  if ((_pText != nullptr) || (_textSource != nullptr))
   {
     switch (_fsmState)
     {
@@ -514,8 +1563,8 @@ bool MD_PZone::zoneAnimate(void)
 
       case INITIALISE:
         PRINT_STATE("ANIMATE");
-#if TIME_PROFILING
-        cycleStartTime = millis();
+#if ENA_ZONE_STATS
+        _statCycleStart = now;
 #endif
         setInitialConditions();
         _moveIn = true;
@@ -523,54 +1572,21 @@ bool MD_PZone::zoneAnimate(void)
 
       default: // All state except END are handled by the special effect functions
         PRINT_STATE("ANIMATE");
-        switch (_moveIn ? _effectIn : _effectOut)
         {
-        case PA_PRINT:        effectPrint(_moveIn);           break;
-        case PA_SCROLL_UP:    effectVScroll(true, _moveIn);   break;
-        case PA_SCROLL_DOWN:  effectVScroll(false, _moveIn);  break;
-        case PA_SCROLL_LEFT:  effectHScroll(true, _moveIn);   break;
-        case PA_SCROLL_RIGHT: effectHScroll(false, _moveIn);  break;
-#if ENA_MISC
-        case PA_SLICE:    effectSlice(_moveIn);     break;
-        case PA_MESH:     effectMesh(_moveIn);      break;
-        case PA_FADE:     effectFade(_moveIn);      break;
-        case PA_BLINDS:   effectBlinds(_moveIn);    break;
-        case PA_DISSOLVE: effectDissolve(_moveIn);  break;
-        case PA_RANDOM:   effectRandom(_moveIn);    break;
-#endif // ENA_MISC
-#if ENA_SPRITE
-        case PA_SPRITE:
-          effectSprite(_moveIn, _moveIn ? _effectIn : _effectOut);  break;
-#endif // ENA_SPRITE
-#if ENA_WIPE
-        case PA_WIPE:         effectWipe(false, _moveIn); break;
-        case PA_WIPE_CURSOR:  effectWipe(true, _moveIn);  break;
-#endif // ENA_WIPE
-#if ENA_SCAN
-        case PA_SCAN_HORIZX: effectHScan(_moveIn, true); break;
-        case PA_SCAN_HORIZ:  effectHScan(_moveIn, false); break;
-        case PA_SCAN_VERTX:  effectVScan(_moveIn, true); break;
-        case PA_SCAN_VERT:   effectVScan(_moveIn, false); break;
-#endif // ENA_SCAN
-#if ENA_OPNCLS
-        case PA_OPENING:        effectOpen(false, _moveIn); break;
-        case PA_OPENING_CURSOR: effectOpen(true, _moveIn);  break;
-        case PA_CLOSING:        effectClose(false, _moveIn); break;
-        case PA_CLOSING_CURSOR: effectClose(true, _moveIn); break;
-#endif // ENA_OPNCLS
-#if ENA_SCR_DIA
-        case PA_SCROLL_UP_LEFT:     effectDiag(true, true, _moveIn);  break;
-        case PA_SCROLL_UP_RIGHT:    effectDiag(true, false, _moveIn); break;
-        case PA_SCROLL_DOWN_LEFT:   effectDiag(false, true, _moveIn); break;
-        case PA_SCROLL_DOWN_RIGHT:  effectDiag(false, false, _moveIn); break;
-#endif // ENA_SCR_DIA
-#if ENA_GROW
-        case PA_GROW_UP:     effectGrow(true, _moveIn);  break;
-        case PA_GROW_DOWN:   effectGrow(false, _moveIn); break;
-#endif // ENA_GROW
-        default:
-          _fsmState = END;
-      }
+          effectFunc_t fn = getEffect(_moveIn ? _effectIn : _effectOut);
+
+          // resolve the text scan direction once for the whole frame
+          _textReverse = (ZE_TEST(_zoneEffect, ZE_FLIP_LR_MASK) != SFX(PA_SCROLL_RIGHT));
+
+          // a text source can only be read forward, one character at a time
+          if ((_textSource != nullptr) && (_textReverse || !(SFX(PA_SCROLL_LEFT) || SFX(PA_SCROLL_RIGHT))))
+            fn = nullptr;
+
+          if (fn != nullptr)
+            fn(this, _moveIn);
+          else
+            _fsmState = END;
+        }
 
       // one way toggle for input to output, reset on initialize
       _moveIn = _moveIn && !(_fsmState == PAUSE);
@@ -578,17 +1594,18 @@ bool MD_PZone::zoneAnimate(void)
     }
   }
 
-#if  TIME_PROFILING
-  Serial.print("\nAnim time: ");
-  Serial.print(millis() - _lastRunTime);
-  if (_fsmState == END)
+#if ENA_ZONE_STATS
   {
-    Serial.print("\nCycle time: ");
-    Serial.print(millis() - cycleStartTime);
+    uint32_t t = micros() - renderStart;
+
+    _statFrames++;
+    _statRenderTotal += t;
+    if (t < _statRenderMin) _statRenderMin = t;
+    if (t > _statRenderMax) _statRenderMax = t;
+    if (_fsmState == END)
+      _statCycleTime = now - _statCycleStart;
   }
 #endif
-
-  return(_fsmState == END);
 }
 
 #if DEBUG_PAROLA_FSM
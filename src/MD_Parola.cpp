@@ -36,7 +36,7 @@ MD_Parola::~MD_Parola(void)
 #endif
 }
 
-bool MD_Parola::begin(uint8_t numZones)
+bool MD_Parola::begin(uint8_t numZones, effectLookup_t effects)
 {
   bool b = _D.begin();    // method return status
 
@@ -57,7 +57,7 @@ bool MD_Parola::begin(uint8_t numZones)
   {
     for (uint8_t i = 0; (i < _numZones) && b; i++)
     {
-      b = b && _Z[i].begin(&_D);
+      b = b && _Z[i].begin(&_D, effects);
     }
 
     if (b)
@@ -93,6 +93,19 @@ bool MD_Parola::setZone(uint8_t z, uint8_t moduleStart, uint8_t moduleEnd)
   return(false);
 }
 
+bool MD_Parola::setZonePair(uint8_t zLead, uint8_t zFollow, uint8_t charOffset)
+{
+  if ((zLead < _numZones) && (zFollow < _numZones) && (zLead != zFollow) &&
+      !_Z[zLead].isPairFollower() && !_Z[zFollow].isPairFollower() &&
+      !_Z[zLead].isPairLead() && !_Z[zFollow].isPairLead())
+  {
+    _Z[zLead].setPairZone(&_Z[zFollow], charOffset);
+    return(true);
+  }
+
+  return(false);
+}
+
 void MD_Parola::displayZoneText(uint8_t z, const char *pText, textPosition_t align, uint16_t speed, uint16_t pause, textEffect_t effectIn, textEffect_t effectOut)
 {
   setTextBuffer(z, pText);
@@ -104,44 +117,107 @@ void MD_Parola::displayZoneText(uint8_t z, const char *pText, textPosition_t ali
   displayReset(z);
 }
 
+void MD_Parola::displayZoneText(uint8_t z, const __FlashStringHelper *pText, textPosition_t align, uint16_t speed, uint16_t pause, textEffect_t effectIn, textEffect_t effectOut)
+{
+  setTextBuffer(z, pText);
+  setTextAlignment(z, align);
+  setSpeed(z, speed);
+  setPause(z, pause);
+  setTextEffect(z, effectIn, effectOut);
+
+  displayReset(z);
+}
+
 bool MD_Parola::displayAnimate(void)
 {
   bool b = false;
+  bool bFlush = false;
+  uint32_t now = millis();  // same time reference for all zones
+
+  // Only touch the hardware if at least one zone will advance a frame,
+  // otherwise there is nothing new to send to the display.
+  for (uint8_t i = 0; (i < _numZones) && !bFlush; i++)
+    bFlush = (_Z[i].getFrameWait(now) == 0);
 
   // suspend the display while we animate a frame
-  _D.update(MD_MAX72XX::OFF);
+  if (bFlush)
+    _D.update(MD_MAX72XX::OFF);
 
   for (uint8_t i = 0; i < _numZones; i++)
-    b |= _Z[i].zoneAnimate();
+    b |= _Z[i].zoneAnimate(now);
 
-  // re-enable and update the display
-  _D.update(MD_MAX72XX::ON);
+  if (bFlush)
+  {
+    // re-enable and update the display
+#if ENA_ZONE_STATS
+    uint32_t t = micros();
+#endif
+    _D.update(MD_MAX72XX::ON);
+#if ENA_ZONE_STATS
+    t = micros() - t;
+    for (uint8_t i = 0; i < _numZones; i++)
+      _Z[i].recordFlushTime(t);
+#endif
+    _flushCount++;
+  }
+  else
+    _flushSkipCount++;
 
   return(b);
 }
 
+uint32_t MD_Parola::msUntilNextFrame(void)
+{
+  uint32_t now = millis();
+  uint32_t wait = PA_NO_DEADLINE;
+
+  for (uint8_t i = 0; i < _numZones && wait != 0; i++)
+  {
+    uint32_t t = _Z[i].getFrameWait(now);
+
+    if (t < wait) wait = t;
+  }
+
+  return(wait);
+}
 
-size_t MD_Parola::write(const char *str)
-// .print() extension of a string
+uint32_t MD_Parola::getNextDeadline(void)
 {
-  displayText((char *)str, getTextAlignment(), 0, 0, PA_PRINT, PA_NO_EFFECT);
-  while (displayAnimate())
-    /* do nothing */;
+  uint32_t wait = msUntilNextFrame();
 
-  return(strlen(str));
+  return(wait == PA_NO_DEADLINE ? PA_NO_DEADLINE : millis() + wait);
+}
+
+size_t MD_Parola::write(uint8_t c)
+// .print() extension of a character
+{
+  if (c == '\n')
+    flush();
+  else if (c != '\r')
+  {
+    if (!_Z[_printZone].printChar(c))
+      return(0);
+  }
+
+  return(1);
 }
 
 size_t MD_Parola::write(const uint8_t *buffer, size_t size)
 // .print() extension
 {
-  char *psz = (char *)malloc(sizeof(char) * (size + 1));
+  size_t n = 0;
+
+  while (size-- != 0)
+    n += write(*buffer++);
 
-  if (psz == nullptr) return(0);
+  return(n);
+}
 
-  memcpy(psz, buffer, size);
-  psz[size] = '\0';
-  write(psz);
-  free(psz);
+void MD_Parola::flush(void)
+// Display the print zone's buffer
+{
+  const char *pText = _Z[_printZone].printLine();
 
-  return(size);
+  if (pText != nullptr)
+    displayZoneText(_printZone, pText, getTextAlignment(_printZone), 0, 0, PA_PRINT, PA_NO_EFFECT);
 }
@@ -51,6 +51,32 @@ Parola A-to-Z Blog Articles
 If you like and use this library please consider making a small donation using [PayPal](https://paypal.me/MajicDesigns/4USD)
 
 \page pageRevHistory Revision History
+Oct 2026 - version 3.8.0
+- Added optional per-zone render cache for text drawn by commonPrint() (setRenderCache()).
+- Added msUntilNextFrame() and getNextDeadline() to allow the application to sleep between frames.
+- displayAnimate() only updates the hardware when a zone animation advances (getFlushStats()).
+- User defined characters held in a fixed size hash table (USER_CHAR_TABLE) instead of a linked list.
+- Zone font header parsed and indexed once when the font is set, no font change per character.
+- Text width remembered between animation cycles for unchanged text (getWidthCacheStats()).
+- Added host build shim and virtual MD_MAX72XX in extras/host for running the library on a workstation.
+- Added effect benchmark program in extras/host.
+- Replaced TIME_PROFILING debug output with zone timing statistics (getZoneStats(), off by default with ENA_ZONE_STATS).
+- Horizontal scroll exit no longer reads back the zone on every frame to detect the end.
+- Vertical and diagonal scrolls shift columns in one step instead of one bit at a time.
+- PA_RANDOM selects pixels using an LFSR sequence held in each zone, giving a fixed number of frames.
+- Added per-zone scratch data for effects (_fx union in MD_PZone), sized by the enabled effects.
+- Effects are called through a function table, added user defined effects (setUserEffect(), PA_USER_1-4).
+- Added MD_ParolaFx and MD_EffectSet to link only the effects listed by the application.
+- Added setZonePair() to animate double height zone pairs in step from one zone.
+- Added fixed timestep frame timing with catch up or skip for late frames (setFrameTiming()).
+- Print class output is buffered without allocation and displayed on newline or flush(), without blocking.
+- Added UTF-8 decoding of the zone text (setUTF8()).
+- Text scan direction resolved once per frame and message length cached for reverse scans.
+- Added zone message playlists that advance automatically (setPlaylist()).
+- Added text source functions for text of unlimited length (setTextSource()).
+- Text can be displayed directly from PROGMEM using __FlashStringHelper overloads.
+- Added inline markup codes for font, inversion, spacing and glyphs in the zone text (setMarkup(), off by default with ENA_MARKUP).
+
 Mar 2024 - version 3.7.3
 - Reviewed uint8_t to uint16_t animation loop indices for large displays.
 - Added contributed speites to sprite library (wheel, hourglass).
@@ -322,6 +348,11 @@ the MD_MAX72xx font builder.
 Each zone can have its own substituted font. The default font can be reselected for the zone by
 specifying a nullptr font table pointer.
 
+When a font is set the zone builds an index of FONT_INDEX_SIZE character offsets (default 16,
+2 bytes each) so that finding a character only skips over the few characters between index
+entries. A larger index uses more RAM in every zone but finds characters in large fonts faster.
+Offsets are 16 bit, so characters more than 64kB from the start of the font data are not shown.
+
 ### More Information
 - [Parola A to Z - Defining Fonts](https://arduinoplusplus.wordpress.com/2016/11/08/parola-fonts-a-to-z-defining-fonts/)
 - [Parola A to Z - Managing Fonts](https://arduinoplusplus.wordpress.com/2016/11/13/parola-fonts-a-to-z-managing-fonts/)
@@ -335,10 +366,18 @@ Individual characters can be substituted for user character definitions. These c
 deleted to individual zones as required.
 
 The character data is the same format as a single character from the font definition file,
-and is held in a local lookup table that is parsed before loading the defined font character.
+and is held in a local lookup table that is checked before loading the defined font character.
 If a character is specified with a code the same as an existing character, the existing data
 will be substituted for the new data.
 
+The lookup table is a fixed size hash table allocated the first time a character is added
+to the zone. It holds up to USER_CHAR_TABLE characters (default 16, must be a power of 2),
+which can be changed by defining the value in the library header file. Each table entry
+takes 4 bytes of RAM on AVR (6 or 8 on 32 bit processors) in every zone that uses user
+defined characters, so an application that needs 40 characters should set USER_CHAR_TABLE
+to 64. addChar() returns false when the table is full. Deleted characters free their
+table entry for reuse.
+
 ASCII 0 character ('\0') cannot be substituted as this denotes the end of string character
 for C++ and cannot be used in an actual string.
 
@@ -388,6 +427,15 @@ _NOTE_: Compile switches must be edited in the library header file. Arduino head
 'mashing' during compilation makes the setting of these switches from user code
 completely unreliable.
 
+The text effects can also be selected in the application, without editing the library,
+by listing the effects used in an MD_ParolaFx object instead of MD_Parola:
+
+    MD_ParolaFx<PA_SCROLL_LEFT, PA_PRINT> P = MD_ParolaFx<PA_SCROLL_LEFT, PA_PRINT>(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+
+Only the listed effects are linked, and any other library effect behaves like PA_NO_EFFECT.
+The listed effects must still be enabled by their ENA_ switch, otherwise they also behave
+like PA_NO_EFFECT.
+
 ### More Information
 - [Parola A to Z - Optimizing Flash Memory](https://arduinoplusplus.wordpress.com/2018/09/23/parola-a-to-z-optimizing-flash-memory/)
 
@@ -400,7 +448,16 @@ effects:
 - Choose a name for the effect and add it to the textEffect_t enumerated type.
 - Clone an existing method and modify it according to the guidelines below.
 - Add the function prototype for the new effect to the MD_PZone class definition in the MD_Parola.h file.
-- Modify the zoneAnimate() method in MD_PZone.cpp to invoke the new method.
+- Add a static effectFunc_t wrapper for the new method to MD_PZone and add it to the effect
+table (_effectTable) in MD_PZone.cpp, in the same position as the effect in textEffect_t.
+
+zoneAnimate() calls the effect for each frame through the table, indexed by the effect id.
+
+Applications can also add their own effects without changing the library by using the
+setUserEffect() method. User effects are functions of type effectFunc_t and use the public
+MD_PZone methods in the 'Support methods for user defined effects' group to get the FSM state,
+print the text and load characters in the same way as library effects. The
+Parola_User_Effect example shows how this is done.
 
 ###New Text Effects
 The effects functions are implemented as finite state machines that are called with the
@@ -431,6 +488,14 @@ set to END by the method.  Aside from the INITIALISE state (set by the displayRe
 all other state changes are under the control of the effect functions. Delays between frames and
 the pause between IN and OUT are handled outside of the effect method.
 
+Effects keep their working data in the zone variables _nextPos, _posOffset, _startPos and _endPos.
+An effect that needs more than this should add a structure for its data to the _fx union in the
+MD_PZone class, within the same ENA_* switch as the effect. The union is part of each zone, so
+effects do not need to allocate memory and several zones can run the same effect at the same time.
+Static variables in the effect method must not be used as they are shared by all the zones. The
+_fx data is not initialised, so the effect must set it up in the INITIALISE (IN) or PAUSE (OUT)
+state.
+
 ### More Information
 - [Parola A to Z - Text Animation](https://arduinoplusplus.wordpress.com/2017/02/10/parola-a-to-z-text-animation/)
 - [Parola A to Z - Managing Animation](https://arduinoplusplus.wordpress.com/2017/03/02/parola-a-to-z-managing-animation/)
@@ -493,10 +558,44 @@ takes about 1-2ms to update in the MD_MAX72XX display buffers.
 #ifndef ENA_GRAPHICS
 #define ENA_GRAPHICS  1 ///< Enable graphics functionality
 #endif
+#ifndef ENA_ZONE_STATS
+#define ENA_ZONE_STATS  0 ///< Enable collection of zone animation timing statistics
+#endif
+#ifndef ENA_MARKUP
+#define ENA_MARKUP  0   ///< Enable inline markup codes in the zone text
+#endif
 
 // Miscellaneous defines
 #define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))  ///< Generic macro for obtaining number of elements of an array
 #define STATIC_ZONES 0    ///< Developer testing flag for quickly flipping between static/dynamic zones
+#define RANDOM_CYCLE 11   ///< PA_RANDOM effect pixel mask repeats every RANDOM_CYCLE columns
+#define USER_EFFECTS 4    ///< Number of user defined effects, PA_USER_1 onwards
+
+#ifndef USER_CHAR_TABLE
+#define USER_CHAR_TABLE 16  ///< Maximum number of user defined characters in each zone. Must be a power of 2. See the User Characters section.
+#endif
+
+#ifndef STREAM_LOOKAHEAD
+#define STREAM_LOOKAHEAD 5   ///< Bytes read ahead from a text source. Must hold the longest character (4 UTF-8 bytes) plus one.
+#endif
+
+#ifndef MARKUP_ESCAPE
+#define MARKUP_ESCAPE '~'  ///< Character that starts a markup code in the zone text. See setMarkup().
+#endif
+
+#ifndef MARKUP_FONTS
+#define MARKUP_FONTS  4   ///< Number of fonts that can be selected by markup codes in each zone
+#endif
+
+#define MARKUP_RUNS   255 ///< Maximum number of runs the zone text is split into by markup codes. See setMarkup().
+
+#ifndef PRINT_BUFFER_SIZE
+#define PRINT_BUFFER_SIZE 32 ///< Size of the Print class text buffer, including the nul terminator. Each zone that is printed to allocates the buffer twice.
+#endif
+
+#ifndef FONT_INDEX_SIZE
+#define FONT_INDEX_SIZE 16  ///< Number of entries in each zone's index of font character offsets. See the Fonts section.
+#endif
 
 #if STATIC_ZONES
 #ifndef MAX_ZONES
@@ -504,6 +603,14 @@ takes about 1-2ms to update in the MD_MAX72XX display buffers.
 #endif
 #endif
 
+#define PA_NO_DEADLINE  0xffffffffUL ///< Time returned when there is no animation frame pending
+#define PA_SOURCE_END   (-1)  ///< Text source return value at the end of the text
+#define PA_SOURCE_WAIT  (-2)  ///< Text source return value when the next byte is not available yet
+
+#ifndef FRAME_CATCHUP_MAX
+#define FRAME_CATCHUP_MAX 4 ///< Maximum frames run in one call to catch up with PA_FRAME_CATCHUP, more late frames are run by the following calls
+#endif
+
 // Zone column calculations
 #define ZONE_START_COL(m) ((m) * COL_SIZE)    ///< The first column of the first zone module
 #define ZONE_END_COL(m)   ((((m) + 1) * COL_SIZE) - 1)///< The last column of the last zone module
@@ -574,6 +681,10 @@ enum textEffect_t
   PA_GROW_UP,     ///< Text grows from the bottom up and shrinks from the top down
   PA_GROW_DOWN,   ///< Text grows from the top down and and shrinks from the bottom up
 #endif // ENA_GROW
+  PA_USER_1,      ///< User defined effect set with setUserEffect()
+  PA_USER_2,      ///< User defined effect set with setUserEffect()
+  PA_USER_3,      ///< User defined effect set with setUserEffect()
+  PA_USER_4,      ///< User defined effect set with setUserEffect()
 };
 
 /**
@@ -592,6 +703,96 @@ enum zoneEffect_t
   PA_FLIP_LR, ///< Flip the zone Left to Right (effectively mirrored). Does not work with textEffect_t types SLICE, SCROLL_LEFT, SCROLL_RIGHT
 };
 
+/**
+ * Frame timing enumerated type specification.
+ *
+ * Used to define how the time for the next animation frame is worked out when
+ * displayAnimate() is not called often enough to run every frame on time.
+ */
+enum frameTiming_t
+{
+  PA_FRAME_FREE,    ///< The next frame is timed from when the last frame ran, so any lateness adds to the animation time
+  PA_FRAME_CATCHUP, ///< The next frame is timed from when the last frame was due, late frames are run together to catch up
+  PA_FRAME_SKIP,    ///< The next frame is timed from when the last frame was due, frames that are late are skipped and the animation ends later
+};
+
+#if ENA_ZONE_STATS
+/**
+ * Zone animation timing statistics.
+ *
+ * Filled in by the getZoneStats() method. Frame render and display update
+ * times are in microseconds, all other times are in milliseconds.
+ */
+struct zoneStats_t
+{
+  uint32_t frames;       ///< number of animation frames run
+  uint32_t renderMin;    ///< shortest time to animate a frame
+  uint32_t renderMax;    ///< longest time to animate a frame
+  uint32_t renderMean;   ///< average time to animate a frame
+  uint32_t flushMax;     ///< longest time to update the display hardware after a frame
+  uint32_t flushMean;    ///< average time to update the display hardware after a frame
+  uint32_t cycleTime;    ///< duration of the last completed animation cycle
+  uint32_t lateFrames;   ///< number of frames run later than the animation speed
+  uint32_t pauseOverrun; ///< total time the pause between IN and OUT exceeded the pause time
+};
+#endif
+
+/**
+ * Zone playlist entry.
+ *
+ * A playlist is an application defined array of these entries, set for a zone
+ * with setPlaylist(). The fields match the parameters of displayZoneText().
+ * The array is not copied, so it must remain in scope while the playlist is in use.
+ * Entries may be changed (eg, enabled or disabled) while the playlist is running,
+ * and the changes are picked up the next time the entry is started. Message text
+ * can be held in PROGMEM by setting the flash field for the entry.
+ */
+struct playlistEntry_t
+{
+  const char    *pText;     ///< the text for the message
+  textPosition_t align;     ///< alignment of the message in the zone
+  uint16_t       speed;     ///< frame time for the IN and OUT animations
+  uint16_t       pause;     ///< pause between the IN and OUT animations
+  textEffect_t   effectIn;  ///< IN animation effect
+  textEffect_t   effectOut; ///< OUT animation effect
+  uint8_t        repeat;    ///< number of times the message is shown in a row (0 is the same as 1)
+  bool           enabled;   ///< the entry is skipped if this is false
+  bool           flash;     ///< pText points to a PROGMEM string, false if it is left out of the initializer
+};
+
+class MD_PZone;
+
+/**
+ * Text effect function type.
+ *
+ * All text effects, including user defined effects set with setUserEffect(), are
+ * called through a function of this type. The function is passed the zone being
+ * animated and whether the text is moving into (true) or out of (false) the display.
+ */
+typedef void (*effectFunc_t)(MD_PZone *z, bool bIn);
+
+/**
+ * Text source function type.
+ *
+ * A zone set up with setTextSource() reads its text through a function of this
+ * type, one byte at a time, instead of from a text buffer. The function returns
+ * the next byte of the text (1-255), PA_SOURCE_WAIT if the next byte is not
+ * available yet, or PA_SOURCE_END (or a nul byte) at the end of the text.
+ */
+typedef int16_t (*textSource_t)(void);
+
+/**
+ * Effect set lookup function type.
+ *
+ * A zone finds the function for a library text effect through a function of this
+ * type, set when the display is initialized. The lookup returns nullptr for effects
+ * that are not part of the set. Only the effects that the lookup function refers to
+ * are linked into the application.
+ *
+ * \sa MD_PZone::allEffects(), MD_EffectSet, MD_ParolaFx
+ */
+typedef effectFunc_t (*effectLookup_t)(textEffect_t id);
+
 /**
  * Zone object for the Parola library.
  * This class contains the text to be displayed and all the attributes for the zone.
@@ -613,9 +814,10 @@ public:
    * new data for the class that cannot be done during the object creation.
    *
    * \param p pointer to the parent's MD_MAX72xx object.
+   * \param effects the lookup function for the library effects available in the zone.
    * \return true if initialization completed successfully, false otherwise
    */
-  bool begin(MD_MAX72XX *p);
+  bool begin(MD_MAX72XX *p, effectLookup_t effects);
 
   /**
    * Class Destructor.
@@ -635,9 +837,33 @@ public:
    * Animate using the currently specified text and animation parameters.
    * This method is invoked from the main Parola object.
    *
+   * \param now  the current millis() time, read once by the caller for all zones.
+   * \return bool true if the zone animation has completed, false otherwise.
+   */
+  bool zoneAnimate(uint32_t now);
+
+  /**
+   * Animate the zone.
+   *
+   * Same as the namesake method, reading the current time from millis().
+   *
    * \return bool true if the zone animation has completed, false otherwise.
    */
-  bool zoneAnimate(void);
+  inline bool zoneAnimate(void) { return(zoneAnimate(millis())); }
+
+  /**
+   * Get the time to the next animation frame.
+   *
+   * Work out how long before the next animation frame is due, taking into
+   * account the IN/OUT frame speed and the pause between animations.
+   *
+   * See comments for the MD_Parola msUntilNextFrame() method.
+   *
+   * \param now  the current millis() time.
+   * \return the number of milliseconds until the zone is due to animate, 0 if
+   * it is due now or PA_NO_DEADLINE if the zone is completed or suspended.
+   */
+  uint32_t getFrameWait(uint32_t now);
 
   /**
    * Get the completion status.
@@ -648,7 +874,7 @@ public:
    *
    * \return bool true if the zone animation is completed
    */
-  bool getStatus(void) { return (_fsmState == END); }
+  bool getStatus(void) { return((_fsmState == END) && ((_pairZone == nullptr) || (_pairZone->_fsmState == END))); }
 
   /**
    * Get the start and end parameters for a zone.
@@ -670,6 +896,34 @@ public:
   */
   bool isAnimationAdvanced(void) { return(_animationAdvanced); }
 
+#if ENA_ZONE_STATS
+  /**
+  * Get the zone animation timing statistics.
+  *
+  * See comments for the MD_Parola getZoneStats() method.
+  *
+  * \param stats  the statistics are placed in this structure.
+  */
+  void getStats(zoneStats_t &stats);
+
+  /**
+  * Reset the zone animation timing statistics.
+  *
+  * See comments for the MD_Parola getZoneStats() method.
+  */
+  void resetStats(void);
+
+  /**
+  * Record the time taken to update the display hardware.
+  *
+  * Called by the main Parola object after the display has been updated. The
+  * time is only counted if the zone advanced a frame in the last animation.
+  *
+  * \param t  the update time in microseconds.
+  */
+  inline void recordFlushTime(uint32_t t) { if (_animationAdvanced) { _statFlushTotal += t; if (t > _statFlushMax) _statFlushMax = t; } }
+#endif
+
   /**
    * Clear the zone.
    *
@@ -704,6 +958,71 @@ public:
    */
   inline void zoneSuspend(bool b) { _suspend = b; }
 
+  /**
+   * Link a follower zone to this zone.
+   *
+   * See comments for the MD_Parola setZonePair() method.
+   *
+   * \param z       the follower zone, nullptr to remove the link.
+   * \param offset  the character code offset for the follower zone.
+   */
+  void setPairZone(MD_PZone *z, uint8_t offset);
+
+  /**
+   * Add a character to the zone print buffer.
+   *
+   * The buffer is allocated the first time it is used.
+   * See comments for the MD_Parola write() method.
+   *
+   * \param c  the character to add.
+   * \return false if the buffer is full or could not be allocated.
+   */
+  bool printChar(uint8_t c);
+
+  /**
+   * End the line in the zone print buffer.
+   *
+   * The printed text is copied to a second buffer that holds the text being
+   * displayed, and the print buffer is emptied for the next line.
+   * See comments for the MD_Parola flush() method.
+   *
+   * \return pointer to the text to display, nullptr if the buffer could not be allocated.
+   */
+  const char *printLine(void);
+
+  /**
+   * Set the message playlist for the zone.
+   *
+   * See comments for the MD_Parola namesake method.
+   *
+   * \param list  the array of playlist entries, nullptr to remove the playlist.
+   * \param size  the number of entries in the array.
+   */
+  void setPlaylist(playlistEntry_t *list, uint8_t size);
+
+  /**
+   * Get the current playlist entry.
+   *
+   * See comments for the MD_Parola namesake method.
+   *
+   * \return the index of the playlist entry being displayed.
+   */
+  inline uint8_t getPlaylistIndex(void) { return(_playlistIdx); }
+
+  /**
+   * Check if the zone is animated by a lead zone.
+   *
+   * \return true if the zone is the follower of a zone pair.
+   */
+  inline bool isPairFollower(void) { return(_pairFollower); }
+
+  /**
+   * Check if the zone animates a follower zone.
+   *
+   * \return true if the zone is the lead of a zone pair.
+   */
+  inline bool isPairLead(void) { return(_pairZone != nullptr); }
+
   /**
    * Set the start and end parameters for a zone.
    *
@@ -712,7 +1031,42 @@ public:
    * \param zStart  the first module number for the zone [0..numZones-1].
    * \param zEnd  the last module number for the zone [0..numZones-1].
    */
-  inline void setZone(uint8_t zStart, uint8_t zEnd) { _zoneStart = zStart; _zoneEnd = zEnd; }
+  inline void setZone(uint8_t zStart, uint8_t zEnd) { _zoneStart = zStart; _zoneEnd = zEnd; _renderValid = false; }
+
+  /**
+   * Enable or disable the rendered text cache for the zone.
+   *
+   * See comments for the MD_Parola namesake method.
+   *
+   * \param b  boolean value to enable (true) or disable (false).
+   */
+  void setRenderCache(bool b);
+
+  /**
+   * Get the memory used by the rendered text cache.
+   *
+   * See comments for the MD_Parola namesake method.
+   *
+   * \return the number of bytes allocated to the cache.
+   */
+  inline uint16_t getRenderCacheSize(void) { return(_renderSize); }
+
+  /**
+   * Get the text width cache statistics.
+   *
+   * See comments for the MD_Parola namesake method.
+   *
+   * \param hits    the number of text width requests answered from the cache.
+   * \param misses  the number of text width requests that measured the text.
+   */
+  inline void getWidthCacheStats(uint32_t &hits, uint32_t &misses) { hits = _widthHits; misses = _widthMisses; }
+
+  /**
+   * Reset the text width cache statistics.
+   *
+   * See comments for the MD_Parola namesake method.
+   */
+  inline void resetWidthCacheStats(void) { _widthHits = _widthMisses = 0; }
 
   /** @} */
   //--------------------------------------------------------------
@@ -727,6 +1081,13 @@ public:
    */
   inline uint8_t getCharSpacing(void) { return _charSpacing; }
 
+  /**
+   * Get the zone frame timing mode.
+   *
+   * \return the current frame timing mode.
+   */
+  inline frameTiming_t getFrameTiming(void) { return(_frameTiming); }
+
   /**
   * Get the zone brightness.
   *
@@ -812,12 +1173,15 @@ public:
    *  Get the width of text in columns
    *
    * Calculate the width of the characters and the space between them
-   * using the current font and text settings.
+   * using the current font and text settings. The last width measured
+   * is remembered and returned again if the text pointer, text content,
+   * font and character spacing are unchanged.
    *
    * \param p   pointer to a text string
+   * \param flash true if the text string is in PROGMEM
    * \return the width of the string in display columns
    */
-   uint16_t getTextWidth(const uint8_t* p);
+   uint16_t getTextWidth(const uint8_t* p, bool flash = false);
 
   /**
    * Get the value of specified display effect.
@@ -837,7 +1201,16 @@ public:
    *
    * \param cs  space between characters in columns.
    */
-  inline void setCharSpacing(uint8_t cs) { _charSpacing = cs; allocateFontBuffer(); }
+  inline void setCharSpacing(uint8_t cs) { _charSpacing = cs; _renderValid = false; allocateFontBuffer(); }
+
+  /**
+   * Set the zone frame timing mode.
+   *
+   * See comments for the namesake Parola method.
+   *
+   * \param ft  the frame timing mode.
+   */
+  inline void setFrameTiming(frameTiming_t ft) { _frameTiming = ft; }
 
   /**
    * Set the zone brightness.
@@ -944,7 +1317,7 @@ public:
    *
    * \param ta  the required text alignment.
    */
-  inline void setTextAlignment(textPosition_t ta) { _textAlignment = ta; }
+  inline void setTextAlignment(textPosition_t ta) { _textAlignment = ta; _renderValid = false; }
 
   /**
    * Set the pointer to the text buffer for this zone.
@@ -954,7 +1327,25 @@ public:
    *
    * \param pb  pointer to the text buffer to be used.
    */
-  inline void setTextBuffer(const char *pb) { _pText = (const uint8_t *)pb; }
+  inline void setTextBuffer(const char *pb) { _pText = (const uint8_t *)pb; _pTextEnd = nullptr; _textFlash = false; _textSource = nullptr; _renderValid = false; }
+
+  /**
+   * Set the pointer to a PROGMEM text buffer for this zone.
+   *
+   * See the comments for the namesake method in MD_Parola.
+   *
+   * \param pb  pointer to the PROGMEM text to be used.
+   */
+  inline void setTextBuffer(const __FlashStringHelper *pb) { setTextBuffer((const char *)pb); _textFlash = true; }
+
+  /**
+   * Set the text source function for this zone.
+   *
+   * See the comments for the namesake method in MD_Parola.
+   *
+   * \param fn  the text source function, nullptr to go back to the text buffer.
+   */
+  inline void setTextSource(textSource_t fn) { _textSource = fn; _streamLen = 0; _streamEnd = false; _renderValid = false; }
 
   /**
    * Set the entry and exit text effects for the zone.
@@ -995,7 +1386,7 @@ public:
    * end of string character for C++ and cannot be used in an actual string.
    * The library does not copy the in the data in the data definition but only retains
    * a pointer to the data, so any changes to the data storage in the calling program will
-   * be reflected in the library.
+   * be reflected in the library. Up to USER_CHAR_TABLE characters can be defined.
    *
    * \param code  code for the character data.
    * \param data  pointer to the character data.
@@ -1025,50 +1416,92 @@ public:
   inline MD_MAX72XX::fontType_t* getZoneFont(void) { return _fontDef; };
 
   /**
-   * Set the display font.
+   * Get the character code offset.
+   *
+   * \return the offset added to character codes before they are looked up.
+   */
+  inline uint8_t getCharOffset(void) { return(_charOffset); }
+
+  /**
+   * Set the character code offset.
+   *
+   * The offset is added to each character code in the text before it is looked up in the
+   * user characters and the font. This allows the same text to display the other half
+   * of a double height font.
+   *
+   * \param offset  the character code offset.
+   */
+  inline void setCharOffset(uint8_t offset) { _charOffset = offset; _renderValid = false; _widthValid = false; }
+
+  /**
+   * Get the UTF-8 text setting.
+   *
+   * \return true if the text is decoded as UTF-8.
+   */
+  inline bool getUTF8(void) { return(_utf8); }
+
+  /**
+   * Set the UTF-8 text setting.
    *
    * See comments for the namesake Parola method.
    *
-   * \param fontDef Pointer to the font definition to be used.
+   * \param b  true to decode the text as UTF-8, false for one byte per character.
    */
-  void setZoneFont(MD_MAX72XX::fontType_t *fontDef) { _fontDef = fontDef; _MX->setFont(_fontDef); allocateFontBuffer(); }
+  inline void setUTF8(bool b) { _utf8 = b; _renderValid = false; _widthValid = false; }
 
-  /** @} */
+#if ENA_MARKUP
+  /**
+   * Get the markup text setting.
+   *
+   * See comments for the namesake Parola method.
+   *
+   * \return true if markup codes in the text are interpreted.
+   */
+  inline bool getMarkup(void) { return(_markup); }
 
-#if ENA_GRAPHICS
-  //--------------------------------------------------------------
-  /** \name Support methods for graphics.
-  * @{
-  */
   /**
-  * Get the start and end column numbers for the zone.
-  *
-  * Returns the start and end column numbers for the zone display.
-  * This retains consistency between user code and library.
-  *
-  * \param startColumn the by-reference parameter that will hold the return value for the start column.
-  * \param endColumn the by-reference parameter that will hold the return value for the end column.
-  */
-  void getZoneExtent(uint16_t &startColumn, uint16_t &endColumn) { startColumn = ZONE_START_COL(_zoneStart); endColumn = ZONE_END_COL(_zoneEnd); }
+   * Set the markup text setting.
+   *
+   * See comments for the namesake Parola method.
+   *
+   * \param b  true to interpret markup codes in the text, false to display them.
+   */
+  inline void setMarkup(bool b) { _markup = b; _runCount = 0; _renderValid = false; _widthValid = false; }
 
   /**
-  * Get the start and end column numbers for the text displayed.
-  *
-  * Returns the start and end column numbers for the text displayed in the zone.
-  * This retains consistency between user code and library.
-  *
-  * \param startColumn the by-reference parameter that will hold the return value for the start column.
-  * \param endColumn the by-reference parameter that will hold the return value for the end column.
-  */
-  void getTextExtent(uint16_t &startColumn, uint16_t &endColumn) { startColumn = _limitLeft; endColumn = _limitRight; }
+   * Set a font that can be selected by markup.
+   *
+   * See comments for the namesake Parola method.
+   *
+   * \param f        the markup font number [1..MARKUP_FONTS].
+   * \param fontDef  pointer to the font definition, nullptr to use the zone font.
+   */
+  void setMarkupFont(uint8_t f, MD_MAX72XX::fontType_t *fontDef);
+#endif
+
+  /**
+   * Set the display font.
+   *
+   * See comments for the namesake Parola method.
+   *
+   * \param fontDef Pointer to the font definition to be used.
+   */
+  void setZoneFont(MD_MAX72XX::fontType_t *fontDef);
 
   /** @} */
-#endif
 
-private:
-   /***
-    *  Finite State machine states enumerated type.
+  //--------------------------------------------------------------
+  /** \name Support methods for user defined effects.
+  * @{
   */
+  /**
+   * Finite State machine states enumerated type.
+   *
+   * A user defined effect is first called with INITIALISE when the text moves in to the
+   * display and must set PAUSE when the text is in its final position. It is first called
+   * with PAUSE when the text moves out and must set END when finished. The other states
+   * can be used by the effect as needed.
+   */
   enum fsmState_t
   {
     INITIALISE,     ///< Initialize all variables
@@ -1080,24 +1513,245 @@ private:
     END             ///< Display cycle has completed
   };
 
-  /***
-    *  Structure for list of user defined characters substitutions.
-  */
-  struct charDef_t
-  {
-    uint16_t      code;   ///< the ASCII code for the user defined character
-    const uint8_t *data;  ///< user supplied data
-    charDef_t     *next;  ///< next in the list
-  };
-
-  MD_MAX72XX  *_MX;   ///< Pointer to parent's MD_MAX72xx object passed in at begin()
-
-  // Time and speed controlling data and methods
-  bool      _suspend;     // don't do anything
-  uint32_t  _lastRunTime; // the millis() value for when the animation was last run
-  uint16_t  _tickTimeIn;  // the time between IN animations in milliseconds
-  uint16_t  _tickTimeOut; // the time between OUT animations in milliseconds
-  uint16_t  _pauseTime;   // time to pause the animation between 'in' and 'out'
+  /**
+   * Set a user defined text effect.
+   *
+   * See comments for the namesake Parola method.
+   *
+   * \param id  the effect being defined, one of PA_USER_1 to PA_USER_4.
+   * \param fn  the effect function, nullptr to remove the effect.
+   * \return true if the effect was set.
+   */
+  bool setUserEffect(textEffect_t id, effectFunc_t fn);
+
+  /**
+   * Get the function for a library text effect.
+   *
+   * Evaluated at compile time to build effect sets (see MD_EffectSet) without
+   * referring to the effects that are not in the set.
+   *
+   * \param id  the library effect.
+   * \return the effect function, nullptr if id is not a library effect.
+   */
+  static constexpr effectFunc_t libraryEffect(textEffect_t id)
+  {
+    return(id == PA_PRINT ? fxPrint :
+      id == PA_SCROLL_UP ? fxScrollUp :
+      id == PA_SCROLL_DOWN ? fxScrollDown :
+      id == PA_SCROLL_LEFT ? fxScrollLeft :
+      id == PA_SCROLL_RIGHT ? fxScrollRight :
+#if ENA_SPRITE
+      id == PA_SPRITE ? fxSprite :
+#endif
+#if ENA_MISC
+      id == PA_SLICE ? fxSlice :
+      id == PA_MESH ? fxMesh :
+      id == PA_FADE ? fxFade :
+      id == PA_DISSOLVE ? fxDissolve :
+      id == PA_BLINDS ? fxBlinds :
+      id == PA_RANDOM ? fxRandom :
+#endif
+#if ENA_WIPE
+      id == PA_WIPE ? fxWipe :
+      id == PA_WIPE_CURSOR ? fxWipeCursor :
+#endif
+#if ENA_SCAN
+      id == PA_SCAN_HORIZ ? fxScanHoriz :
+      id == PA_SCAN_HORIZX ? fxScanHorizX :
+      id == PA_SCAN_VERT ? fxScanVert :
+      id == PA_SCAN_VERTX ? fxScanVertX :
+#endif
+#if ENA_OPNCLS
+      id == PA_OPENING ? fxOpening :
+      id == PA_OPENING_CURSOR ? fxOpeningCursor :
+      id == PA_CLOSING ? fxClosing :
+      id == PA_CLOSING_CURSOR ? fxClosingCursor :
+#endif
+#if ENA_SCR_DIA
+      id == PA_SCROLL_UP_LEFT ? fxScrollUpLeft :
+      id == PA_SCROLL_UP_RIGHT ? fxScrollUpRight :
+      id == PA_SCROLL_DOWN_LEFT ? fxScrollDownLeft :
+      id == PA_SCROLL_DOWN_RIGHT ? fxScrollDownRight :
+#endif
+#if ENA_GROW
+      id == PA_GROW_UP ? fxGrowUp :
+      id == PA_GROW_DOWN ? fxGrowDown :
+#endif
+      nullptr);
+  }
+
+  /**
+   * Effect lookup for all the library effects.
+   *
+   * This is the effect set used by MD_Parola::begin() and links all the effects
+   * enabled by the ENA_* switches.
+   *
+   * \param id  the library effect.
+   * \return the effect function, nullptr if id is not a library effect.
+   */
+  static effectFunc_t allEffects(textEffect_t id);
+
+  /**
+   * Get the animation state.
+   *
+   * \return the current state of the animation FSM.
+   */
+  inline fsmState_t getEffectState(void) { return(_fsmState); }
+
+  /**
+   * Set the animation state.
+   *
+   * \param s  the new state for the animation FSM.
+   */
+  inline void setEffectState(fsmState_t s) { _fsmState = s; }
+
+  /**
+   * Get the animation position.
+   *
+   * The position is a general purpose value kept by the zone between frames. The
+   * library effects use it to hold the current position in the animation.
+   *
+   * \return the current position value.
+   */
+  inline int16_t getEffectPosition(void) { return(_nextPos); }
+
+  /**
+   * Set the animation position.
+   *
+   * \sa getEffectPosition()
+   *
+   * \param p  the new position value.
+   */
+  inline void setEffectPosition(int16_t p) { _nextPos = p; }
+
+  /**
+   * Print the text in the zone.
+   *
+   * Display the whole message at its final position in the zone, blanking the
+   * columns either side of the text. The text columns can be shifted up or down
+   * at the same time, filling with the background.
+   *
+   * \param shift  number of pixels to shift the text up (> 0) or down (< 0).
+   */
+  void commonPrint(int8_t shift = 0);
+
+  /**
+   * Load the first character of the text.
+   *
+   * Load the first character, in the direction the text is displayed, into the
+   * buffer returned by getCharBuffer().
+   *
+   * \param len  the number of columns loaded is placed here.
+   * \return true if a character was loaded, false if there is no text.
+   */
+  bool getFirstChar(uint8_t &len);
+
+  /**
+   * Load the next character of the text.
+   *
+   * Load the next character, in the direction the text is displayed, into the
+   * buffer returned by getCharBuffer().
+   *
+   * \param len  the number of columns loaded is placed here.
+   * \return true if a character was loaded, false at the end of the text.
+   */
+  bool getNextChar(uint8_t &len);
+
+  /**
+   * Get the character buffer.
+   *
+   * \return pointer to the column data loaded by getFirstChar() and getNextChar().
+   */
+  inline uint8_t *getCharBuffer(void) { return(_cBuf); }
+
+  /**
+  * Get the start and end column numbers for the zone.
+  *
+  * Returns the start and end column numbers for the zone display.
+  * This retains consistency between user code and library.
+  *
+  * \param startColumn the by-reference parameter that will hold the return value for the start column.
+  * \param endColumn the by-reference parameter that will hold the return value for the end column.
+  */
+  void getZoneExtent(uint16_t &startColumn, uint16_t &endColumn) { startColumn = ZONE_START_COL(_zoneStart); endColumn = ZONE_END_COL(_zoneEnd); }
+
+  /**
+  * Get the start and end column numbers for the text displayed.
+  *
+  * Returns the start and end column numbers for the text displayed in the zone.
+  * This retains consistency between user code and library.
+  *
+  * \param startColumn the by-reference parameter that will hold the return value for the start column.
+  * \param endColumn the by-reference parameter that will hold the return value for the end column.
+  */
+  void getTextExtent(uint16_t &startColumn, uint16_t &endColumn) { startColumn = _limitLeft; endColumn = _limitRight; }
+
+  /**
+  * Get the data for a display column.
+  *
+  * \param c  the display column number.
+  * \return the column data.
+  */
+  inline uint8_t getZoneColumn(uint16_t c) { return(_MX->getColumn(c)); }
+
+  /**
+  * Set the data for a display column.
+  *
+  * The column is not read back to compare it first, as MD_MAX72XX only sends
+  * the rows that were written when the display is updated.
+  *
+  * \param c    the display column number.
+  * \param col  the new column data.
+  */
+  inline void setZoneColumn(uint16_t c, uint8_t col) { _MX->setColumn(c, col); }
+
+  /** @} */
+
+private:
+  /***
+    *  Structure for table of user defined characters substitutions.
+  */
+  struct charDef_t
+  {
+    uint16_t      code;   ///< the code for the user defined character, 0 if the table slot is unused
+    const uint8_t *data;  ///< user supplied data
+  };
+
+  /***
+    *  Structure for a font resolved once when it is set.
+  */
+  struct fontInfo_t
+  {
+    MD_MAX72XX::fontType_t *data; ///< font data used, either the font set or the MD_MAX72XX default font
+    uint16_t  first;      ///< first character code in the font
+    uint16_t  last;       ///< last character code in the font
+    uint16_t  step;       ///< number of characters between entries in index
+    uint8_t   maxWidth;   ///< width of the widest character in the font
+    uint16_t  index[FONT_INDEX_SIZE]; ///< offset into data of every step'th character
+  };
+
+#if ENA_MARKUP
+  /***
+    *  Structure for a run of text displayed with the same markup settings.
+  */
+  struct textRun_t
+  {
+    uint16_t start;   ///< offset in the text of the first byte in the run
+    uint16_t end;     ///< offset in the text after the last byte in the run
+    uint8_t  font;    ///< markup font number, 0 for the zone font
+    uint8_t  spacing; ///< character spacing, RUN_SPACING_ZONE for the zone setting
+    uint8_t  flags;   ///< RUN_* flags
+  };
+#endif
+
+  MD_MAX72XX  *_MX;   ///< Pointer to parent's MD_MAX72xx object passed in at begin()
+
+  // Time and speed controlling data and methods
+  bool      _suspend;     // don't do anything
+  uint32_t  _lastRunTime; // the millis() value for when the animation was last run
+  uint16_t  _tickTimeIn;  // the time between IN animations in milliseconds
+  uint16_t  _tickTimeOut; // the time between OUT animations in milliseconds
+  uint16_t  _pauseTime;   // time to pause the animation between 'in' and 'out'
 
   // Display control data and methods
   fsmState_t      _fsmState;          // fsm state for all FSMs used to display text
@@ -1114,8 +1768,35 @@ private:
   uint8_t         _zoneEffect;        // bit mapped zone effects
   uint8_t         _intensity;         // display intensity
   bool            _animationAdvanced; // true is animation advanced inthe last animation call
+  MD_PZone        *_pairZone;         // follower zone animated in step with this zone
+  bool            _pairFollower;      // true if this zone is animated by a lead zone
+  uint8_t         _charOffset;        // offset added to character codes before lookup
+  frameTiming_t   _frameTiming;       // how the time for the next frame is worked out
 
   void      setInitialConditions(void);       // set up initial conditions for an effect
+  void      animateFrame(uint32_t now);       // run one frame of the animation
+  void      advanceClock(uint32_t now);       // set the time base for the frame about to run
+  void      skipFrames(uint32_t now);         // move the time base past the frames that are late
+  uint16_t  frameInterval(void);             // time between the last frame and the next
+  uint32_t  frameWait(uint32_t now);         // time before the next frame of a running animation
+  void      copyToPair(void);                 // start the follower zone with this zone's settings
+
+  // Playlist data and methods
+  playlistEntry_t *_playlist;   // application's array of messages, nullptr if none
+  uint8_t   _playlistSize;      // number of entries in the playlist
+  uint8_t   _playlistIdx;       // the entry currently being displayed
+  uint8_t   _playlistRepeat;    // number of times the current entry is still to be shown
+  bool      nextPlaylistEntry(void);          // start the next enabled playlist entry
+
+  // Print class buffers, 2 * PRINT_BUFFER_SIZE allocated on first use: the line
+  // being printed followed by the text being displayed
+  char      *_printBuf;
+#if PRINT_BUFFER_SIZE > 255
+  uint16_t  _printLen;          // number of characters in the line being printed
+#else
+  uint8_t   _printLen;          // number of characters in the line being printed
+#endif
+  bool      allocatePrintBuffer(void);        // allocate _printBuf if not already done
   bool      calcTextLimits(const uint8_t *p); // calculate the right and left limits for the text
 
   // Variables used in the effects routines. These can be used by the functions as needed.
@@ -1126,19 +1807,60 @@ private:
   int16_t   _startPos;    // Start position for the text LED
   int16_t   _endPos;      // End limit for the text LED.
 
+  // Scratch data for effects that need more state than the variables above. Each
+  // effect declares its own member of the union, so the space is shared by all the
+  // effects and is the size of the largest one enabled by the ENA_* switches.
+  union
+  {
+    uint8_t dummy;    // keeps the union valid when no effects need scratch data
+#if ENA_MISC
+    struct
+    {
+      uint8_t mask[RANDOM_CYCLE]; // pixel mask (one byte per column) for the display
+      uint8_t lfsr;               // LFSR state selecting the next pixel in the mask
+    } random;         // PA_RANDOM
+#endif
+  } _fx;
+
   void setInitialEffectConditions(void); // set the initial conditions for loops in the FSM
 
   // Character buffer handling data and methods
   const uint8_t *_pText;             // pointer to text buffer from user call
+  const uint8_t *_pTextEnd;          // end of text buffer (nul terminator), nullptr until the length is needed
   const uint8_t *_pCurChar;          // the current character being processed in the text
+  bool       _textReverse;           // true if the text is scanned from the end (set once per frame)
+  bool       _textFlash;             // true if the text buffer is in PROGMEM
   bool       _endOfText;             // true when the end of the text string has been reached.
-  void       moveTextPointer(void);  // move the text pointer depending on direction of buffer scan
-
-  bool getFirstChar(uint8_t &len);   // put the first Text char into the char buffer
-  bool getNextChar(uint8_t &len);    // put the next Text char into the char buffer
+  bool       _utf8;                  // true if the text is decoded as UTF-8
+  textSource_t _textSource;          // function supplying the text, nullptr if the text buffer is used
+  uint8_t    _streamBuf[STREAM_LOOKAHEAD + 1];  // bytes read ahead from the text source, nul terminated
+  uint8_t    _streamLen;             // number of bytes in _streamBuf
+  bool       _streamEnd;             // true when the text source has returned the end of the text
+  bool       getStreamChar(uint8_t &len);  // load the next character from the text source
+#if ENA_MARKUP
+  bool       _markup;                // true if markup codes in the text are interpreted
+  textRun_t  *_runs;                 // runs of text between markup codes, allocated on first use
+  uint8_t    _runAlloc;              // number of runs allocated
+  uint8_t    _runCount;              // number of runs in the current text
+  uint8_t    _runIdx;                // the run holding _pCurChar
+  uint8_t    _runSpacingMax;         // widest character spacing set by markup
+  uint32_t   _runHash;               // hash of the text the runs were split from
+  fontInfo_t *_markupFont[MARKUP_FONTS];  // fonts selected by markup, allocated when set
+  uint8_t    parseRuns(textRun_t *runs);    // split the text into runs, count them only if runs is nullptr
+  void       prepareRuns(void);             // split the zone text into the _runs array
+  bool       getRunChar(uint8_t &len);      // load the character at _pCurChar in the current run
+  const uint8_t *lastRunChar(void);         // start of the last character in the current run
+  inline void selectFont(uint8_t f) { _font = ((f != 0) && (_markupFont[f - 1] != nullptr) ? _markupFont[f - 1] : &_zoneFont); } // use a markup font, 0 for the zone font
+  uint8_t    runSpacing(const textRun_t *r);  // character spacing for the run
+#endif
+  void       moveTextPointer(uint8_t n);   // move the text pointer depending on direction of buffer scan
+  uint16_t   decodeChar(const uint8_t *p, uint8_t &n, bool flash);  // character code at p, n is set to the number of bytes used
+  static inline uint8_t textByte(const uint8_t *p, bool flash) { return(flash ? pgm_read_byte(p) : *p); } // read a text byte from RAM or PROGMEM
+  const uint8_t *prevChar(const uint8_t *p);          // start of the character before p
 
   // Font character handling data and methods
-  charDef_t *_userChars;  // the root of the list of user defined characters
+  charDef_t *_userChars;  // hash table of user defined characters, USER_CHAR_TABLE entries allocated on first use
+  uint16_t  _userCharCount; // number of user defined characters in the table
   uint8_t   _cBufSize;    // allocated size of the array for loading character font (cBuf)
   uint8_t   *_cBuf;       // buffer for loading character font - allocated when font is set
   uint8_t   _charSpacing; // spacing in columns between characters
@@ -1146,12 +1868,55 @@ private:
   int16_t   _countCols;   // count of number of columns already shown
   MD_MAX72XX::fontType_t  *_fontDef;  // font for this zone
 
+  // Font handles, resolved once when the font is set
+  fontInfo_t _zoneFont;     // the zone font
+  fontInfo_t *_font;        // the font characters are loaded from, the zone font or a markup font
+
+  void      loadFont(fontInfo_t *fi, MD_MAX72XX::fontType_t *fontDef);   // parse the font header and build the character offset index
+  uint8_t   getFontChar(uint16_t code, uint8_t size, uint8_t *cBuf); // load a character from the current font
   void      allocateFontBuffer(void); // allocate _cBuf based on the size of the largest font characters
   uint8_t   findChar(uint16_t code, uint8_t size, uint8_t *cBuf); // look for user defined character
-  uint8_t   makeChar(uint16_t c, bool addBlank);  // load a character bitmap and add in trailing _charSpacing blanks if req'd
+  charDef_t *findUserChar(uint16_t code);  // find the user defined character table entry
+  inline uint16_t hashChar(uint16_t code) { return((code ^ (code >> 8)) & (USER_CHAR_TABLE - 1)); } // user character table hash
+  uint8_t   makeChar(uint16_t c, bool addBlank, uint8_t spacing);  // load a character bitmap and add in trailing spacing blanks if req'd
   void      reverseBuf(uint8_t *p, uint8_t size); // reverse the elements of the buffer
   void      invertBuf(uint8_t *p, uint8_t size);  // invert the elements of the buffer
 
+  // Rendered text cache data and methods
+  bool      _renderCache;   // true if commonPrint() is drawn from the render cache
+  bool      _renderValid;   // true if the cache content matches the current text and settings
+  bool      _renderReverse; // text direction used when the cache was rendered
+  uint16_t  _renderSize;    // allocated size of the render cache in columns
+  uint8_t   *_renderBuf;    // rendered text columns, from _limitLeft towards _limitRight
+
+  bool      renderText(void); // render the text into the cache, return false if not possible
+
+  // Text width cache data
+  bool      _widthValid;    // true if the cached width matches the key below
+  const uint8_t *_widthText;  // text pointer last measured
+  uint32_t  _widthHash;     // hash of the text content last measured
+  MD_MAX72XX::fontType_t  *_widthFont;  // font used for the last measurement
+  uint8_t   _widthSpacing;  // character spacing used for the last measurement
+  bool      _widthMarkup;   // true if the last measurement used the markup runs
+  uint16_t  _widthCols;     // measured width in columns
+  uint32_t  _widthHits;     // number of widths returned from the cache
+  uint32_t  _widthMisses;   // number of widths measured
+
+#if ENA_ZONE_STATS
+  // Animation timing statistics
+  uint32_t  _statFrames;        // number of frames run
+  uint32_t  _statRenderMin;     // shortest frame animation time in us
+  uint32_t  _statRenderMax;     // longest frame animation time in us
+  uint32_t  _statRenderTotal;   // total frame animation time in us
+  uint32_t  _statFlushMax;      // longest display update time in us
+  uint32_t  _statFlushTotal;    // total display update time in us
+  uint32_t  _statCycleStart;    // millis() time the current animation cycle started
+  uint32_t  _statCycleTime;     // duration of the last animation cycle in ms
+  uint32_t  _statLateFrames;    // number of frames later than the animation speed
+  uint32_t  _statPauseOverrun;  // total pause overrun in ms
+#endif
+
+
   /// Sprite management
 #if ENA_SPRITE
   uint8_t *_spriteInData, *_spriteOutData;
@@ -1162,8 +1927,57 @@ private:
   // Debugging aid
   const char *state2string(fsmState_t s);
 
+  // Effect dispatch
+  effectFunc_t _userEffect[USER_EFFECTS];  // user defined effects, PA_USER_1 onwards
+  effectLookup_t _effectLookup;   // finds the library effects available in this zone
+  static const effectFunc_t _effectTable[];  // library effects indexed by textEffect_t, in PROGMEM
+
+  effectFunc_t getEffect(textEffect_t id);  // get the function for an effect
+
+  static void fxPrint(MD_PZone *z, bool bIn);
+  static void fxScrollUp(MD_PZone *z, bool bIn);
+  static void fxScrollDown(MD_PZone *z, bool bIn);
+  static void fxScrollLeft(MD_PZone *z, bool bIn);
+  static void fxScrollRight(MD_PZone *z, bool bIn);
+#if ENA_SPRITE
+  static void fxSprite(MD_PZone *z, bool bIn);
+#endif // ENA_SPRITE
+#if ENA_MISC
+  static void fxSlice(MD_PZone *z, bool bIn);
+  static void fxMesh(MD_PZone *z, bool bIn);
+  static void fxFade(MD_PZone *z, bool bIn);
+  static void fxDissolve(MD_PZone *z, bool bIn);
+  static void fxBlinds(MD_PZone *z, bool bIn);
+  static void fxRandom(MD_PZone *z, bool bIn);
+#endif // ENA_MISC
+#if ENA_WIPE
+  static void fxWipe(MD_PZone *z, bool bIn);
+  static void fxWipeCursor(MD_PZone *z, bool bIn);
+#endif // ENA_WIPE
+#if ENA_SCAN
+  static void fxScanHoriz(MD_PZone *z, bool bIn);
+  static void fxScanHorizX(MD_PZone *z, bool bIn);
+  static void fxScanVert(MD_PZone *z, bool bIn);
+  static void fxScanVertX(MD_PZone *z, bool bIn);
+#endif // ENA_SCAN
+#if ENA_OPNCLS
+  static void fxOpening(MD_PZone *z, bool bIn);
+  static void fxOpeningCursor(MD_PZone *z, bool bIn);
+  static void fxClosing(MD_PZone *z, bool bIn);
+  static void fxClosingCursor(MD_PZone *z, bool bIn);
+#endif // ENA_OPNCLS
+#if ENA_SCR_DIA
+  static void fxScrollUpLeft(MD_PZone *z, bool bIn);
+  static void fxScrollUpRight(MD_PZone *z, bool bIn);
+  static void fxScrollDownLeft(MD_PZone *z, bool bIn);
+  static void fxScrollDownRight(MD_PZone *z, bool bIn);
+#endif // ENA_SCR_DIA
+#if ENA_GROW
+  static void fxGrowUp(MD_PZone *z, bool bIn);
+  static void fxGrowDown(MD_PZone *z, bool bIn);
+#endif // ENA_GROW
+
   // Effect functions
-  void  commonPrint(void);
   void  effectPrint(bool bIn);
   void  effectVScroll(bool bUp, bool bIn);
   void  effectHScroll(bool bLeft, bool bIn);
@@ -1219,7 +2033,8 @@ public:
    * \param numDevices  number of devices connected. Default is 1 if not supplied.
    */
   MD_Parola(MD_MAX72XX::moduleType_t mod, uint8_t dataPin, uint8_t clkPin, uint8_t csPin, uint8_t numDevices = 1):
-    _D(mod, dataPin, clkPin, csPin, numDevices), _numModules(numDevices)
+    _D(mod, dataPin, clkPin, csPin, numDevices), _numModules(numDevices),
+    _flushCount(0), _flushSkipCount(0), _printZone(0)
   {}
 
   /**
@@ -1235,7 +2050,8 @@ public:
    * \param numDevices  number of devices connected. Default is 1 if not supplied.
    */
   MD_Parola(MD_MAX72XX::moduleType_t mod, uint8_t csPin, uint8_t numDevices = 1):
-    _D(mod, csPin, numDevices), _numModules(numDevices)
+    _D(mod, csPin, numDevices), _numModules(numDevices),
+    _flushCount(0), _flushSkipCount(0), _printZone(0)
   {}
 
     /**
@@ -1253,7 +2069,8 @@ public:
    * \param numDevices  number of devices connected. Default is 1 if not supplied.
    */
   MD_Parola(MD_MAX72XX::moduleType_t mod, SPIClass &spi, uint8_t csPin, uint8_t numDevices = 1):
-    _D(mod, spi, csPin, numDevices), _numModules(numDevices)
+    _D(mod, spi, csPin, numDevices), _numModules(numDevices),
+    _flushCount(0), _flushSkipCount(0), _printZone(0)
   {}
 
   /**
@@ -1281,7 +2098,24 @@ public:
    * \param numZones  maximum number of zones
    * \return true if the initialization complete successfully, false otherwise
    */
-  bool begin(uint8_t numZones);
+  bool begin(uint8_t numZones) { return(begin(numZones, MD_PZone::allEffects)); }
+
+  /**
+   * Initialize the object.
+   *
+   * Initialize the object data as for begin(numZones), with the library effects
+   * limited to the set found by the lookup function. Effects that are not in the set
+   * behave like PA_NO_EFFECT and, if not referred to elsewhere in the application,
+   * are not linked. The effect set is normally created using MD_EffectSet or
+   * MD_ParolaFx.
+   *
+   * \sa MD_EffectSet, MD_ParolaFx
+   *
+   * \param numZones  maximum number of zones
+   * \param effects   lookup function for the library effects used by the application
+   * \return true if the initialization complete successfully, false otherwise
+   */
+  bool begin(uint8_t numZones, effectLookup_t effects);
 
   /**
    * Class Destructor.
@@ -1316,6 +2150,101 @@ public:
    */
   bool displayAnimate(void);
 
+  /**
+   * Get the time until the next animation frame is due.
+   *
+   * Rather than continuously polling displayAnimate(), the calling program can use
+   * this method to find out how long it can spend doing other things (or sleeping)
+   * before the earliest animation frame in any of the zones is due. The frame speed,
+   * the pause between IN and OUT animations and suspended zones are all taken into
+   * account.
+   *
+   * Zones that have completed their animation or are suspended are not waiting for
+   * a frame, so if no zone is currently animating the return value is PA_NO_DEADLINE.
+   *
+   * \sa getNextDeadline()
+   *
+   * \return the number of milliseconds before displayAnimate() next needs to be called,
+   * 0 if an animation frame is already due.
+   */
+  uint32_t msUntilNextFrame(void);
+
+  /**
+   * Get the time for the next animation frame.
+   *
+   * See comments for the msUntilNextFrame() method. This version of the method returns
+   * the millis() time at which the earliest zone animation frame is due.
+   *
+   * \return the millis() value at which displayAnimate() next needs to be called,
+   * PA_NO_DEADLINE if no zones are animating.
+   */
+  uint32_t getNextDeadline(void);
+
+  /**
+   * Get the display update statistics.
+   *
+   * The display hardware is only updated by displayAnimate() when at least one zone
+   * animation is due to advance a frame. Calls where no frame is due leave the hardware
+   * untouched. When the hardware is updated MD_MAX72XX only sends the display rows that
+   * were changed. This method returns the count of calls in each category, which is
+   * useful to tune how often the application calls displayAnimate().
+   *
+   * \sa resetFlushStats()
+   *
+   * \param performed  the number of calls that updated the display hardware.
+   * \param skipped    the number of calls that did not need to update the display hardware.
+   */
+  inline void getFlushStats(uint32_t &performed, uint32_t &skipped) { performed = _flushCount; skipped = _flushSkipCount; }
+
+  /**
+   * Reset the display update statistics.
+   *
+   * \sa getFlushStats()
+   */
+  inline void resetFlushStats(void) { _flushCount = _flushSkipCount = 0; }
+
+#if ENA_ZONE_STATS
+  /**
+   * Get the animation timing statistics for a zone.
+   *
+   * Each zone keeps timing statistics for its animation that can be read at any time
+   * without affecting the animation. Collection adds statistics fields to each zone and
+   * micros() calls to each frame and display update, so it is off by default. Set
+   * ENA_ZONE_STATS to 1 in the library header file to collect the statistics.
+   *
+   * - Frame render time is the time taken to animate one frame into the display buffers.
+   * - Flush time is the time taken by the hardware update after a frame in this zone.
+   * - Cycle time is the time from the start of the IN effect to the end of the OUT effect
+   * for the last completed animation.
+   * - Late frames are frames that ran after more than the animation speed had elapsed since
+   * the previous frame, usually because displayAnimate() was not called often enough.
+   * - Pause overrun is the total time the pause between the IN and OUT effects exceeded
+   * the specified pause time.
+   *
+   * \sa resetZoneStats()
+   *
+   * \param z      zone number.
+   * \param stats  the statistics are placed in this structure.
+   */
+  inline void getZoneStats(uint8_t z, zoneStats_t &stats) { if (z < _numZones) _Z[z].getStats(stats); else memset(&stats, 0, sizeof(stats)); }
+
+  /**
+   * Reset the animation timing statistics for all zones.
+   *
+   * \sa getZoneStats()
+   */
+  void resetZoneStats(void) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].resetStats(); }
+
+  /**
+   * Reset the animation timing statistics for the specified zone.
+   *
+   * \sa getZoneStats()
+   *
+   * \param z  zone number.
+   */
+  inline void resetZoneStats(uint8_t z) { if (z < _numZones) _Z[z].resetStats(); }
+#endif
+
   /**
    * Get the completion status for a zone.
    *
@@ -1440,6 +2369,89 @@ public:
    */
   bool setZone(uint8_t z, uint8_t moduleStart, uint8_t moduleEnd);
 
+  /**
+   * Enable or disable the rendered text cache for all zones.
+   *
+   * Most text effects redraw the whole message for every animation frame, which
+   * means finding and loading every character from the font each time. When the
+   * render cache is enabled, the message is rendered once into a column buffer
+   * whenever the text, font, spacing, alignment or zone effects change, and each
+   * frame is then copied from that buffer. This trades RAM (one byte for each
+   * column of text displayed) for a large reduction in the time taken to
+   * animate a frame, most noticeable on displays with many modules.
+   *
+   * The cache memory is allocated when first needed and released when the
+   * cache is disabled. The cache is disabled by default.
+   *
+   * \sa getRenderCacheSize()
+   *
+   * \param b  boolean value to enable (true) or disable (false).
+   */
+  void setRenderCache(bool b) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].setRenderCache(b); }
+
+  /**
+   * Enable or disable the rendered text cache for the specified zone.
+   *
+   * See comments for the 'all zones' variant of this method.
+   *
+   * \param z   zone number.
+   * \param b   boolean value to enable (true) or disable (false).
+   */
+  inline void setRenderCache(uint8_t z, bool b) { if (z < _numZones) _Z[z].setRenderCache(b); }
+
+  /**
+   * Get the total memory used by the rendered text cache.
+   *
+   * \sa setRenderCache()
+   *
+   * \return the number of bytes allocated to the cache in all zones.
+   */
+  uint16_t getRenderCacheSize(void) { uint16_t n = 0; for (uint8_t i = 0; i < _numZones; i++) n += _Z[i].getRenderCacheSize(); return(n); }
+
+  /**
+   * Get the memory used by the rendered text cache for the specified zone.
+   *
+   * \sa setRenderCache()
+   *
+   * \param z   zone number.
+   * \return the number of bytes allocated to the cache in the specified zone.
+   */
+  inline uint16_t getRenderCacheSize(uint8_t z) { return(z < _numZones ? _Z[z].getRenderCacheSize() : 0); }
+
+  /**
+   * Get the text width cache statistics for all zones.
+   *
+   * The width of the message is measured at the start of every animation cycle
+   * and by getTextColumns(). Each zone remembers the last width measured together
+   * with the text pointer, a hash of the text content, the font and the character
+   * spacing, and only measures the text again when one of these has changed.
+   * A high proportion of hits is expected for repeating messages.
+   *
+   * \sa resetWidthCacheStats()
+   *
+   * \param hits    the number of text width requests answered from the cache.
+   * \param misses  the number of text width requests that measured the text.
+   */
+  void getWidthCacheStats(uint32_t &hits, uint32_t &misses) { uint32_t h, m; hits = misses = 0; for (uint8_t i = 0; i < _numZones; i++) { _Z[i].getWidthCacheStats(h, m); hits += h; misses += m; } }
+
+  /**
+   * Get the text width cache statistics for the specified zone.
+   *
+   * See comments for the 'all zones' variant of this method.
+   *
+   * \param z       zone number.
+   * \param hits    the number of text width requests answered from the cache.
+   * \param misses  the number of text width requests that measured the text.
+   */
+  inline void getWidthCacheStats(uint8_t z, uint32_t &hits, uint32_t &misses) { if (z < _numZones) _Z[z].getWidthCacheStats(hits, misses); else hits = misses = 0; }
+
+  /**
+   * Reset the text width cache statistics for all zones.
+   *
+   * \sa getWidthCacheStats()
+   */
+  void resetWidthCacheStats(void) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].resetWidthCacheStats(); }
+
   /** @} */
   //--------------------------------------------------------------
   /** \name Methods for quick start displays.
@@ -1479,6 +2491,22 @@ public:
   inline void displayText(const char *pText, textPosition_t align, uint16_t speed, uint16_t pause, textEffect_t effectIn, textEffect_t effectOut = PA_NO_EFFECT)
     { displayZoneText(0, pText, align, speed, pause, effectIn, effectOut); }
 
+ /**
+   * Easy start for a non-scrolling PROGMEM text display.
+   *
+   * Same as the namesake method, with the text read directly from PROGMEM.
+   * See the setTextBuffer() method.
+   *
+   * \param pText pointer to the PROGMEM text.
+   * \param align parameter suitable for the the setTextAlignment() method.
+   * \param speed parameter suitable for the setSpeed() method.
+   * \param pause parameter suitable for the setPause() method.
+   * \param effectIn  parameter suitable for the setTextEffect() method.
+   * \param effectOut parameter suitable for the setTextEffect() method.
+   */
+  inline void displayText(const __FlashStringHelper *pText, textPosition_t align, uint16_t speed, uint16_t pause, textEffect_t effectIn, textEffect_t effectOut = PA_NO_EFFECT)
+    { displayZoneText(0, pText, align, speed, pause, effectIn, effectOut); }
+
  /**
    * Easy start for a non-scrolling zone text display.
    *
@@ -1496,6 +2524,69 @@ public:
    */
   void displayZoneText(uint8_t z, const char *pText, textPosition_t align, uint16_t speed, uint16_t pause, textEffect_t effectIn, textEffect_t effectOut = PA_NO_EFFECT);
 
+ /**
+   * Easy start for a non-scrolling zone PROGMEM text display.
+   *
+   * Same as the namesake method, with the text read directly from PROGMEM.
+   * See the setTextBuffer() method.
+   *
+   * \param z   zone specified.
+   * \param pText pointer to the PROGMEM text.
+   * \param align parameter suitable for the the setTextAlignment() method.
+   * \param speed parameter suitable for the setSpeed() method.
+   * \param pause parameter suitable for the setPause() method.
+   * \param effectIn  parameter suitable for the setTextEffect() method.
+   * \param effectOut parameter suitable for the setTextEffect() method.
+   */
+  void displayZoneText(uint8_t z, const __FlashStringHelper *pText, textPosition_t align, uint16_t speed, uint16_t pause, textEffect_t effectIn, textEffect_t effectOut = PA_NO_EFFECT);
+
+ /**
+   * Run a message playlist in a zone.
+   *
+   * The zone displays each enabled entry of the playlist in turn, as if it had been
+   * passed to displayZoneText(), showing the entry repeat times before moving on.
+   * After the last entry the playlist starts again from the first. The next entry
+   * is started by the zone as soon as the previous animation ends, so there is no
+   * need to check the zone status and set up the next message in loop(). As the
+   * animation never ends, getZoneStatus() only returns true if no entry is enabled.
+   *
+   * The array is not copied and must remain in scope while the playlist is in use.
+   * Setting a new playlist starts it from the first enabled entry.
+   *
+   * \param z     zone specified.
+   * \param list  the array of playlist entries.
+   * \param size  the number of entries in the array.
+   */
+  inline void setPlaylist(uint8_t z, playlistEntry_t *list, uint8_t size) { if (z < _numZones) _Z[z].setPlaylist(list, size); }
+
+ /**
+   * Run a message playlist.
+   *
+   * See comments for the namesake method. Assumes one zone only (zone 0).
+   *
+   * \param list  the array of playlist entries.
+   * \param size  the number of entries in the array.
+   */
+  inline void setPlaylist(playlistEntry_t *list, uint8_t size) { setPlaylist(0, list, size); }
+
+ /**
+   * Stop the message playlist in a zone.
+   *
+   * The current message animation runs to the end and the zone then stops
+   * as it would for displayZoneText().
+   *
+   * \param z     zone specified.
+   */
+  inline void clearPlaylist(uint8_t z) { setPlaylist(z, nullptr, 0); }
+
+ /**
+   * Get the current playlist entry for a zone.
+   *
+   * \param z     zone specified.
+   * \return the index of the playlist entry being displayed.
+   */
+  inline uint8_t getPlaylistIndex(uint8_t z) { return (z < _numZones ? _Z[z].getPlaylistIndex() : 0); }
+
   /** @} */
   //--------------------------------------------------------------
   /** \name Support methods for visually adjusting the display.
@@ -1517,6 +2608,25 @@ public:
    */
   inline uint8_t getCharSpacing(uint8_t z) { return (z < _numZones ? _Z[z].getCharSpacing() : 0); }
 
+  /**
+   * Get the frame timing mode.
+   *
+   * See the setFrameTiming() method. Assumes one zone only.
+   *
+   * \return the current frame timing mode.
+   */
+  inline frameTiming_t getFrameTiming(void) { return getFrameTiming(0); }
+
+  /**
+   * Get the frame timing mode for a specific zone.
+   *
+   * See the setFrameTiming() method.
+   *
+   * \param z   zone number.
+   * \return the current frame timing mode for the zone.
+   */
+  inline frameTiming_t getFrameTiming(uint8_t z) { return (z < _numZones ? _Z[z].getFrameTiming() : PA_FRAME_FREE); }
+
   /**
    * Get the current display invert state.
    *
@@ -1650,6 +2760,16 @@ public:
    * \return the number of columns used to display the text.
    */
   inline uint16_t getTextColumns(const char *p) { return(getTextColumns(0, p)); }
+
+ /**
+   * Get the width of PROGMEM text in columns
+   *
+   * See comments for the namesake method. Assumes one zone display.
+   *
+   * \param p   pointer to the PROGMEM text.
+   * \return the number of columns used to display the text.
+   */
+  inline uint16_t getTextColumns(const __FlashStringHelper *p) { return(getTextColumns(0, p)); }
   
  /**
    * Get the text width in columns
@@ -1664,6 +2784,17 @@ public:
    */
   inline uint16_t getTextColumns(uint8_t z, const char *p) { return(z < _numZones && p != nullptr ? _Z[z].getTextWidth((uint8_t *)p) : 0); }
 
+  /**
+   * Get the width of PROGMEM text in columns.
+   *
+   * See comments for the namesake method.
+   *
+   * \param z zone number.
+   * \param p pointer to the PROGMEM text.
+   * \return the number of columns used to display the text.
+   */
+  inline uint16_t getTextColumns(uint8_t z, const __FlashStringHelper *p) { return(z < _numZones && p != nullptr ? _Z[z].getTextWidth((const uint8_t *)p, true) : 0); }
+
  /**
    * Get the value of specified display effect.
    *
@@ -1695,6 +2826,41 @@ public:
    */
   inline void setCharSpacing(uint8_t z, uint8_t cs) { if (z < _numZones) _Z[z].setCharSpacing(cs); }
 
+  /**
+   * Set the frame timing mode for all zones.
+   *
+   * By default (PA_FRAME_FREE) the time for the next frame is counted from when the
+   * last frame actually ran, so every late call to displayAnimate() makes the animation
+   * longer and zones with the same speed slowly drift apart.
+   *
+   * With PA_FRAME_CATCHUP or PA_FRAME_SKIP the next frame is counted from when the last
+   * frame was due, so frames stay on a fixed time base from the start of the animation
+   * and zones with the same speed stay in step.
+   *
+   * When displayAnimate() is called late, PA_FRAME_CATCHUP runs the missed frames so the
+   * animation keeps to its planned finish time. Up to FRAME_CATCHUP_MAX frames are run
+   * in one call and any still late are run in the following calls, so the animation
+   * finishes on time as long as the application calls displayAnimate() often enough to
+   * average no more than FRAME_CATCHUP_MAX frames per call. Late frames are never dropped.
+   *
+   * PA_FRAME_SKIP runs one frame and moves the time base on past the frames that were
+   * missed. The frames stay in step with other zones, but every skipped frame makes the
+   * animation finish one frame time later, so the finish time is not fixed.
+   *
+   * \param ft  the frame timing mode.
+   */
+  inline void setFrameTiming(frameTiming_t ft) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].setFrameTiming(ft); }
+
+  /**
+   * Set the frame timing mode for the specified zone.
+   *
+   * See comments for the 'all zones' variant of this method.
+   *
+   * \param z   zone number.
+   * \param ft  the frame timing mode.
+   */
+  inline void setFrameTiming(uint8_t z, frameTiming_t ft) { if (z < _numZones) _Z[z].setFrameTiming(ft); }
+
   /**
    * Set the display brightness for all the zones.
    *
@@ -1858,6 +3024,33 @@ public:
 
 #endif
 
+  /**
+   * Set a user defined text effect for all zones.
+   *
+   * Up to USER_EFFECTS text effects can be defined by the application and used like the
+   * library effects with the effect ids PA_USER_1 to PA_USER_4. The effect function is
+   * called for every animation frame and works in the same way as the library effects
+   * (see the section on implementing new text effects), using the zone methods in the
+   * 'Support methods for user defined effects' group to get the effect state, print the
+   * text, load characters and change the display columns.
+   *
+   * \param id  the effect being defined, one of PA_USER_1 to PA_USER_4.
+   * \param fn  the effect function, nullptr to remove the effect.
+   */
+  void setUserEffect(textEffect_t id, effectFunc_t fn) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].setUserEffect(id, fn); }
+
+  /**
+   * Set a user defined text effect for the specified zone.
+   *
+   * See comments for the 'all zones' variant of this method.
+   *
+   * \param z   zone number.
+   * \param id  the effect being defined, one of PA_USER_1 to PA_USER_4.
+   * \param fn  the effect function, nullptr to remove the effect.
+   * \return true if the effect was set.
+   */
+  inline bool setUserEffect(uint8_t z, textEffect_t id, effectFunc_t fn) { return(z < _numZones ? _Z[z].setUserEffect(id, fn) : false); }
+
   /**
    * Set the text alignment for all zones.
    *
@@ -1904,6 +3097,68 @@ public:
    */
   inline void setTextBuffer(uint8_t z, const char *pb) { if (z < _numZones) _Z[z].setTextBuffer(pb); }
 
+  /**
+   * Set the pointer to a PROGMEM text buffer.
+   *
+   * The text is read directly from PROGMEM as it is displayed, so fixed messages
+   * do not need to be copied into a RAM buffer first. The text is given as for
+   * the Serial print() methods, either using the F() macro or by casting a PSTR()
+   * or PROGMEM string to (const __FlashStringHelper *).
+   *
+   * This form of the method assumes one zone only.
+   *
+   * \param pb  pointer to the PROGMEM text to be used.
+   */
+  inline void setTextBuffer(const __FlashStringHelper *pb) { setTextBuffer(0, pb); }
+
+  /**
+   * Set the pointer to a PROGMEM text buffer for the specified zone.
+   *
+   * See comments for the single zone version of this method.
+   *
+   * \param z zone number.
+   * \param pb  pointer to the PROGMEM text to be used.
+   */
+  inline void setTextBuffer(uint8_t z, const __FlashStringHelper *pb) { if (z < _numZones) _Z[z].setTextBuffer(pb); }
+
+  /**
+   * Set the text source function.
+   *
+   * A text source is an alternative to the text buffer for text that is too long,
+   * or arrives too slowly, to hold in memory as one message (eg, a news ticker fed
+   * from Serial, a file or a generator). The zone calls the function to read the
+   * text one byte at a time as it is needed, holding only STREAM_LOOKAHEAD bytes,
+   * so the text can be of any length. The animation ends, as it would at the end of
+   * a text buffer, when the function returns PA_SOURCE_END or a nul byte. Bytes not
+   * yet displayed are kept, so the text carries on from the same place when the
+   * animation is restarted.
+   *
+   * When the next byte has not arrived yet the function returns PA_SOURCE_WAIT. The
+   * text already shown keeps scrolling, followed by blank columns, and the function
+   * is called again for the next column until more text is available.
+   *
+   * The text is only read forward and each character is read once, so a text
+   * source can only be used with the PA_SCROLL_LEFT effect, or with PA_SCROLL_RIGHT
+   * when the zone has the PA_FLIP_LR effect set. With any other effect the animation
+   * ends straight away without reading the source. Zone pairs cannot use a text
+   * source. Setting a text buffer removes the text source.
+   *
+   * This form of the method assumes one zone only.
+   *
+   * \param fn  the text source function, nullptr to go back to the text buffer.
+   */
+  inline void setTextSource(textSource_t fn) { setTextSource(0, fn); }
+
+  /**
+   * Set the text source function for the specified zone.
+   *
+   * See comments for the single zone version of this method.
+   *
+   * \param z zone number.
+   * \param fn  the text source function, nullptr to go back to the text buffer.
+   */
+  inline void setTextSource(uint8_t z, textSource_t fn) { if (z < _numZones) _Z[z].setTextSource(fn); }
+
   /**
    * Set the entry and exit text effects for all zones.
    *
@@ -1952,6 +3207,43 @@ public:
   */
   inline void synchZoneStart(void) { for (uint8_t i = 1; i < _numZones; i++) _Z[i].setSynchTime(_Z[0].getSynchTime()); }
 
+  /**
+  * Link two zones as a double height pair.
+  *
+  * The follower zone displays the same text as the lead zone, with charOffset added
+  * to each character code so that the other half of a double height font is shown.
+  * The lead zone's animation drives both zones: each time the lead zone starts an
+  * animation its text, effects, alignment, speed, pause and frame timing are copied to
+  * the follower, together with the UTF-8, inversion, character spacing, scroll spacing
+  * and zone effect (PA_FLIP_UD, PA_FLIP_LR) settings. Every lead zone frame also runs
+  * a follower frame, so the two zones stay in step. The follower keeps its own font and
+  * user defined characters.
+  *
+  * Only the lead zone needs to be given text and animation parameters, and only its
+  * status needs to be checked. Each zone still renders its own half of the characters.
+  * If the halves of the font have different widths the lead zone keeps running the
+  * follower after its own animation ends, and is only completed when both zones are.
+  *
+  * A zone can only be in one pair. Use clearZonePair() before linking a lead zone
+  * to a different follower.
+  *
+  * \param zLead   the lead zone number.
+  * \param zFollow the follower zone number.
+  * \param charOffset  the character code offset for the follower zone.
+  * \return true if the zones were linked, false if a zone number is invalid or
+  * either zone is already part of a pair.
+  */
+  bool setZonePair(uint8_t zLead, uint8_t zFollow, uint8_t charOffset);
+
+  /**
+  * Remove the double height link for a zone.
+  *
+  * \sa setZonePair()
+  *
+  * \param zLead   the lead zone number.
+  */
+  inline void clearZonePair(uint8_t zLead) { if (zLead < _numZones) _Z[zLead].setPairZone(nullptr, 0); }
+
 /** @} */
   //--------------------------------------------------------------
   /** \name Support methods for fonts and characters.
@@ -1971,10 +3263,13 @@ public:
    * so any changes to the data storage in the calling program will be reflected into the
    * library. The data must also remain in scope while it is being used.
    *
+   * Each zone can hold up to USER_CHAR_TABLE user defined characters.
+   *
    * \param code  code for the character data.
    * \param data  pointer to the character data.
+   * \return true if the character was inserted in the substitution list of every zone.
    */
-  inline void addChar(uint16_t code, const uint8_t *data) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].addChar(code, data); }
+  inline bool addChar(uint16_t code, const uint8_t *data) { bool b = true; for (uint8_t i = 0; i < _numZones; i++) b &= _Z[i].addChar(code, data); return(b); }
 
   /**
    * Add a user defined character to the replacement specified zone.
@@ -2050,6 +3345,135 @@ public:
    */
   inline void setFont(uint8_t z, MD_MAX72XX::fontType_t *fontDef) { if (z < _numZones) _Z[z].setZoneFont(fontDef); }
 
+  /**
+   * Get the UTF-8 text setting.
+   *
+   * See the setUTF8() method. Assumes one zone only.
+   *
+   * \return true if the text is decoded as UTF-8.
+   */
+  inline bool getUTF8(void) { return getUTF8(0); }
+
+  /**
+   * Get the UTF-8 text setting for a specific zone.
+   *
+   * See the setUTF8() method.
+   *
+   * \param z   zone number.
+   * \return true if the text in the zone is decoded as UTF-8.
+   */
+  inline bool getUTF8(uint8_t z) { return (z < _numZones ? _Z[z].getUTF8() : false); }
+
+  /**
+   * Set the UTF-8 text setting for all zones.
+   *
+   * By default each byte of the text is one character. When UTF-8 is set, multi-byte
+   * UTF-8 sequences in the text are decoded as they are displayed, in either direction,
+   * and the code point is used to look up the character. Code points up to 255 are
+   * taken from the font (ISO 8859-1 for the extended ASCII fonts), other characters can
+   * be defined with addChar(). Bytes that are not valid UTF-8 are used as single
+   * characters and code points above 0xffff are shown as 0xfffd.
+   *
+   * \param b  true to decode the text as UTF-8, false for one byte per character.
+   */
+  inline void setUTF8(bool b) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].setUTF8(b); }
+
+  /**
+   * Set the UTF-8 text setting for the specified zone.
+   *
+   * See comments for the 'all zones' variant of this method.
+   *
+   * \param z   zone number.
+   * \param b   true to decode the text as UTF-8, false for one byte per character.
+   */
+  inline void setUTF8(uint8_t z, bool b) { if (z < _numZones) _Z[z].setUTF8(b); }
+
+#if ENA_MARKUP
+  /**
+   * Get the markup text setting.
+   *
+   * See the setMarkup() method. Assumes one zone only.
+   *
+   * \return true if markup codes in the text are interpreted.
+   */
+  inline bool getMarkup(void) { return getMarkup(0); }
+
+  /**
+   * Get the markup text setting for a specific zone.
+   *
+   * See the setMarkup() method.
+   *
+   * \param z   zone number.
+   * \return true if markup codes in the text of the zone are interpreted.
+   */
+  inline bool getMarkup(uint8_t z) { return (z < _numZones ? _Z[z].getMarkup() : false); }
+
+  /**
+   * Set the markup text setting for all zones.
+   *
+   * When markup is set, codes starting with the MARKUP_ESCAPE character ('~' by default)
+   * in the text change how the rest of the text is displayed:
+   * - ~F<i>n</i> selects markup font <i>n</i> ('1' to the MARKUP_FONTS digit), set with
+   *   setMarkupFont(). ~F0 selects the zone font.
+   * - ~I turns on inverted (dark on light) characters and ~i turns it off.
+   * - ~S<i>n</i> sets the spacing between characters to the digit <i>n</i>.
+   *   ~Sz goes back to the zone setCharSpacing() value.
+   * - ~U<i>c</i> displays the byte <i>c</i> as a character code, without UTF-8 decoding.
+   *   This is useful for characters defined with addChar().
+   * - ~~ displays the '~' character.
+   *
+   * Other codes are ignored. For example, "Next ~Itrain~i at ~F110:15" shows 'train'
+   * inverted and the time in markup font 1.
+   *
+   * The text is split into runs of characters with the same settings when it is first
+   * measured, so the markup is not parsed again for each frame. The runs are held in
+   * memory allocated by the zone. The text is split into at most MARKUP_RUNS runs, and
+   * each code can end one run and start another. Once the limit is close, the last run
+   * continues to the end of the text and any markup codes in it are displayed as
+   * characters. Markup fonts are prepared by setMarkupFont(), so changing font between
+   * runs costs nothing. Markup is not applied to the text from setTextSource(), and
+   * getTextColumns() only applies it to the text being displayed by the zone.
+   *
+   * Markup is not compiled into the library by default. Set ENA_MARKUP to 1 in the
+   * library header file to use it.
+   *
+   * \param b  true to interpret markup codes in the text, false to display them.
+   */
+  inline void setMarkup(bool b) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].setMarkup(b); }
+
+  /**
+   * Set the markup text setting for the specified zone.
+   *
+   * See comments for the 'all zones' variant of this method.
+   *
+   * \param z   zone number.
+   * \param b   true to interpret markup codes in the text, false to display them.
+   */
+  inline void setMarkup(uint8_t z, bool b) { if (z < _numZones) _Z[z].setMarkup(b); }
+
+  /**
+   * Set a font that can be selected by markup for all zones.
+   *
+   * See the setMarkup() method. Markup fonts are used in the same way as the
+   * zone font set with setFont().
+   *
+   * \param f        the markup font number [1..MARKUP_FONTS].
+   * \param fontDef  pointer to the font definition, nullptr to use the zone font.
+   */
+  inline void setMarkupFont(uint8_t f, MD_MAX72XX::fontType_t *fontDef) { for (uint8_t i = 0; i < _numZones; i++) _Z[i].setMarkupFont(f, fontDef); }
+
+  /**
+   * Set a font that can be selected by markup for the specified zone.
+   *
+   * See comments for the 'all zones' variant of this method.
+   *
+   * \param z        zone number.
+   * \param f        the markup font number [1..MARKUP_FONTS].
+   * \param fontDef  pointer to the font definition, nullptr to use the zone font.
+   */
+  inline void setMarkupFont(uint8_t z, uint8_t f, MD_MAX72XX::fontType_t *fontDef) { if (z < _numZones) _Z[z].setMarkupFont(f, fontDef); }
+#endif
+
   /** @} */
 
 #if ENA_GRAPHICS
@@ -2125,39 +3549,33 @@ public:
   /**
   * Write a single character to the output display
   *
-  * Display a character when given the ASCII code for it. The character is
-  * converted to a string and the string printing function invoked.
-  * The LED display is designed for string based output, so it does not make much
-  * sense to do this. Creating the short string is a consistent way to way to handle
-  * single the character.
+  * Characters are added to the print buffer until a newline is written or flush()
+  * is called, when the buffer is displayed in the print zone. Carriage returns
+  * are ignored, so println() displays the line. Characters that do not fit in the
+  * buffer (PRINT_BUFFER_SIZE) are discarded.
+  *
+  * Each zone has its own print buffers, allocated the first time text is printed
+  * to the zone, so an application that does not print uses no memory for them.
   *
   * \param c  ASCII code for the character to write.
   * \return the number of characters written.
   */
-  virtual size_t write(uint8_t c) { char sz[2]; sz[0] = c; sz[1] = '\0'; write(sz); return(1); }
+  virtual size_t write(uint8_t c);
 
   /**
   * Write a nul terminated string to the output display.
   *
-  * Display a nul terminated string when given a pointer to the char array.
-  * Invokes an animation using PA_PRINT with all other settings (alignment,
-  * speed, etc) taken from current defaults.
-  * This method also invokes the animation for the print and returns when that has
-  * finished, so it blocks while the printing is happening, which should be at least
-  * one iteration of the wait loop.
+  * The string is added to the print buffer, see write(uint8_t).
   *
   * \param str  Pointer to the nul terminated char array.
   * \return the number of characters written.
   */
-  virtual size_t write(const char *str);
+  virtual size_t write(const char *str) { return(str == nullptr ? 0 : write((const uint8_t *)str, strlen(str))); }
 
   /**
   * Write a character buffer to the output display.
   *
-  * Display a non-nul terminated string given a pointer to the buffer and
-  * the size of the buffer. The buffer is turned into a nul terminated string
-  * and the simple write() method is invoked. Memory is allocated and freed
-  * in this method to copy the string.
+  * The buffer is added to the print buffer, see write(uint8_t).
   *
   * \param buffer Pointer to the data buffer.
   * \param size The number of bytes to write.
@@ -2165,6 +3583,33 @@ public:
   */
   virtual size_t write(const uint8_t *buffer, size_t size);
 
+  /**
+  * Display the printed text.
+  *
+  * The text in the print buffer is displayed in the print zone using PA_PRINT,
+  * with the zone's current alignment, and the buffer is emptied for the next line.
+  * The method returns straight away and the text is displayed by the next calls to
+  * displayAnimate(), so displayAnimate() must be called regularly as for any other
+  * animation. The print buffer is also displayed when a newline is printed.
+  */
+  virtual void flush(void);
+
+  /**
+  * Get the print zone.
+  *
+  * \return the zone used to display printed text.
+  */
+  inline uint8_t getPrintZone(void) { return(_printZone); }
+
+  /**
+  * Set the print zone.
+  *
+  * Set the zone used to display the printed text. The default is zone 0.
+  *
+  * \param z   zone number.
+  */
+  inline void setPrintZone(uint8_t z) { if (z < _numZones) _printZone = z; }
+
   /** @} */
 
   private:
@@ -2177,5 +3622,68 @@ public:
 #endif
   uint8_t     _numModules;///< Number of display modules [0..numModules-1]
   uint8_t     _numZones;  ///< Max number of zones in the display [0..numZones-1]
+  uint32_t    _flushCount;      ///< Number of displayAnimate() calls that updated the hardware
+  uint32_t    _flushSkipCount;  ///< Number of displayAnimate() calls with nothing to update
+
+  // Print class extension
+  uint8_t     _printZone; ///< Zone used to display printed text
+};
+
+
+/**
+ * Compile time set of library text effects.
+ *
+ * The set is defined by listing the effects in the template parameters, for example
+ * MD_EffectSet<PA_SCROLL_LEFT, PA_PRINT>. The find() method is an effect lookup that
+ * refers only to the listed effects and is passed to MD_Parola::begin() so that the
+ * other effects are not linked into the application. Effects disabled by their ENA_*
+ * switch are not available even when they are listed.
+ */
+template <textEffect_t... E> struct MD_EffectSet;
+
+/// \cond
+template <> struct MD_EffectSet<>
+{
+  static effectFunc_t find(textEffect_t) { return(nullptr); }
+};
+
+template <textEffect_t F, textEffect_t... R> struct MD_EffectSet<F, R...>
+{
+  static effectFunc_t find(textEffect_t id) { return(id == F ? MD_PZone::libraryEffect(F) : MD_EffectSet<R...>::find(id)); }
 };
+/// \endcond
+
+/**
+ * Parola object with a compile time set of text effects.
+ *
+ * Used in the same way as MD_Parola, with the library effects used by the application
+ * listed in the template parameters. Only the listed effects are linked, and effects not
+ * in the list behave like PA_NO_EFFECT. A listed effect must still be enabled by its ENA_*
+ * switch, otherwise it also behaves like PA_NO_EFFECT. User defined effects can be used as normal.
+ *
+ * MD_ParolaFx<PA_SCROLL_LEFT, PA_PRINT> P = MD_ParolaFx<PA_SCROLL_LEFT, PA_PRINT>(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+ */
+template <textEffect_t... E> class MD_ParolaFx : public MD_Parola
+{
+public:
+  using MD_Parola::MD_Parola;
 
+  /**
+   * Initialize the object.
+   *
+   * See comments for the namesake MD_Parola method.
+   *
+   * \return true if the initialization complete successfully, false otherwise
+   */
+  bool begin(void) { return(begin(1)); }
+
+  /**
+   * Initialize the object.
+   *
+   * See comments for the namesake MD_Parola method.
+   *
+   * \param numZones  maximum number of zones
+   * \return true if the initialization complete successfully, false otherwise
+   */
+  bool begin(uint8_t numZones) { return(MD_Parola::begin(numZones, MD_EffectSet<E...>::find)); }
+};
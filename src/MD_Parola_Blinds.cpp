@@ -50,7 +50,7 @@ void MD_PZone::effectBlinds(bool bIn)
     for (int16_t i = ZONE_START_COL(_zoneStart); i <= ZONE_END_COL(_zoneEnd); i++)
     {
       if (i % BLINDS_SIZE < _nextPos)
-        _MX->setColumn(i, LIGHT_BAR);
+        setZoneColumn(i, LIGHT_BAR);
     }
 
     if (_nextPos == BLINDS_SIZE)
@@ -62,14 +62,13 @@ void MD_PZone::effectBlinds(bool bIn)
 
   case GET_NEXT_CHAR:   // blinds opening
     PRINT_STATE("IO BLIND");
-    zoneClear();
-    if (bIn) commonPrint(); // only do this when putting the message up
+    if (bIn) commonPrint(); else zoneClear(); // only put the message up when coming in
 
     _nextPos--;
     for (int16_t i = ZONE_START_COL(_zoneStart); i <= ZONE_END_COL(_zoneEnd); i++)
     {
       if (i % BLINDS_SIZE < _nextPos)
-        _MX->setColumn(i, LIGHT_BAR);
+        setZoneColumn(i, LIGHT_BAR);
     }
 
     if (_nextPos == 0)
@@ -78,8 +77,7 @@ void MD_PZone::effectBlinds(bool bIn)
 
   case PUT_CHAR:
     PRINT_STATE("IO BLIND");
-    zoneClear();
-    if (bIn) commonPrint();
+    if (bIn) commonPrint(); else zoneClear();
     _fsmState = (bIn ? PAUSE : END);
     break;
 
@@ -44,8 +44,8 @@ void MD_PZone::effectClose(bool bLightBar, bool bIn)
       zoneClear();
       if (bLightBar)
       {
-        _MX->setColumn(_limitLeft, LIGHT_BAR);
-        _MX->setColumn(_limitRight,LIGHT_BAR);
+        setZoneColumn(_limitLeft, LIGHT_BAR);
+        setZoneColumn(_limitRight,LIGHT_BAR);
       }
       _fsmState = PUT_CHAR;
       // fall through
@@ -53,7 +53,6 @@ void MD_PZone::effectClose(bool bLightBar, bool bIn)
     case PUT_CHAR:
       PRINT_STATE("I CLOSE");
       FSMPRINT(" - offset ", _nextPos);
-      zoneClear();
       commonPrint();
       {
         const int16_t halfWidth = (_limitLeft - _limitRight) / 2;
@@ -65,13 +64,13 @@ void MD_PZone::effectClose(bool bLightBar, bool bIn)
         else
         {
           for (int16_t i = _limitRight + _nextPos + 1; i < _limitLeft - _nextPos; i++)
-            _MX->setColumn(i, EMPTY_BAR);
+            setZoneColumn(i, EMPTY_BAR);
 
           _nextPos++;
           if (bLightBar && (_nextPos <= halfWidth))
           {
-            _MX->setColumn(_limitLeft - _nextPos, LIGHT_BAR);
-            _MX->setColumn(_limitRight + _nextPos, LIGHT_BAR);
+            setZoneColumn(_limitLeft - _nextPos, LIGHT_BAR);
+            setZoneColumn(_limitRight + _nextPos, LIGHT_BAR);
           }
         }
       }
@@ -95,12 +94,11 @@ void MD_PZone::effectClose(bool bLightBar, bool bIn)
       FSMPRINT(" L:", _limitLeft);
       _nextPos = (_limitLeft - _limitRight) / 2;
       FSMPRINT(" O:", _nextPos);
-      zoneClear();
       commonPrint();
       if (bLightBar)
       {
-        _MX->setColumn(_limitLeft - _nextPos, LIGHT_BAR);
-        _MX->setColumn(_limitRight + _nextPos, LIGHT_BAR);
+        setZoneColumn(_limitLeft - _nextPos, LIGHT_BAR);
+        setZoneColumn(_limitRight + _nextPos, LIGHT_BAR);
       }
       _fsmState = PUT_CHAR;
       break;
@@ -114,14 +112,14 @@ void MD_PZone::effectClose(bool bLightBar, bool bIn)
       }
       else
       {
-        _MX->setColumn(_limitLeft - _nextPos, EMPTY_BAR);
-        _MX->setColumn(_limitRight + _nextPos, EMPTY_BAR);
+        setZoneColumn(_limitLeft - _nextPos, EMPTY_BAR);
+        setZoneColumn(_limitRight + _nextPos, EMPTY_BAR);
 
         _nextPos--;
         if (bLightBar && (_nextPos >= 0))
         {
-          _MX->setColumn(_limitLeft - _nextPos, LIGHT_BAR);
-          _MX->setColumn(_limitRight + _nextPos, LIGHT_BAR);
+          setZoneColumn(_limitLeft - _nextPos, LIGHT_BAR);
+          setZoneColumn(_limitRight + _nextPos, LIGHT_BAR);
         }
       }
       break;
@@ -49,50 +49,33 @@ void MD_PZone::effectDiag(bool bUp, bool bLeft, bool bIn)
     case PAUSE:
       PRINT_STATE("I DIAG");
 
-      zoneClear();
-      commonPrint();
-
-      // scroll each column of the display so that the message appears to be animated
+      // print the message scrolled vertically by the current position and then move
+      // the columns sideways so that the message appears to be animated diagonally.
       // Note: Directions are reversed here because we start with the message in the
-      // middle position thru commonPrint() and to see it animated moving DOWN we
-      // need to scroll it UP, and vice versa.
+      // middle position and to see it animated moving DOWN we need to scroll it UP,
+      // and vice versa.
+      commonPrint(bUp ? _nextPos : -_nextPos);
       if (bLeft)
       {
         for (int16_t j = _nextPos; j <= ZONE_END_COL(_zoneEnd); j++)   // for each column
         {
-          uint8_t c = _MX->getColumn(j);
-
-          for (int16_t i = _nextPos; i > 0; i--)
-          {
-            c = (bUp ? c << 1 : c >> 1);
-            if (_inverted) c |= (bUp ? 0x01 : 0x80);
-          }
-
-          _MX->setColumn(j - _nextPos, c);
+          setZoneColumn(j - _nextPos, _MX->getColumn(j));
         }
 
         // clear last few columns to the left of the text displayed
         for (int16_t j = 0; j < _nextPos; j++)
-          _MX->setColumn(ZONE_END_COL(_zoneEnd) - j, EMPTY_BAR);
+          setZoneColumn(ZONE_END_COL(_zoneEnd) - j, EMPTY_BAR);
       }
       else  // going right
       {
         for (int16_t j = ZONE_END_COL(_zoneEnd) - _nextPos + 1; j >= ZONE_START_COL(_zoneStart); j--)   // for each column
         {
-          uint8_t c = _MX->getColumn(j);
-
-          for (int16_t i = _nextPos; i > 0; i--)
-          {
-            c = (bUp ? c << 1 : c >> 1);
-            if (_inverted) c |= (bUp ? 0x01 : 0x80);
-          }
-
-          _MX->setColumn(j + _nextPos, c);
+          setZoneColumn(j + _nextPos, _MX->getColumn(j));
         }
 
         // clear last few columns to the right of the text displayed
         for (int16_t j = 0; j < _nextPos; j++)
-          _MX->setColumn(ZONE_START_COL(_zoneStart) + j, EMPTY_BAR);
+          setZoneColumn(ZONE_START_COL(_zoneStart) + j, EMPTY_BAR);
       }
 
       // check if we have finished
@@ -121,32 +104,29 @@ void MD_PZone::effectDiag(bool bUp, bool bLeft, bool bIn)
     case GET_NEXT_CHAR:
     case PUT_CHAR:
       PRINT_STATE("O DIAG");
-
-      if (bLeft)
       {
-        for (int16_t j = ZONE_END_COL(_zoneEnd) - 1; j >= ZONE_START_COL(_zoneStart); j--)   // for each column
-        {
-          uint8_t c = _MX->getColumn(j);
+        uint8_t fill = (_inverted ? (bUp ? 0x80 : 0x01) : 0);
 
-          c = (bUp ? c >> 1 : c << 1);
-          if (_inverted) c |= (bUp ? 0x80 : 0x01);
+        if (bLeft)
+        {
+          for (int16_t j = ZONE_END_COL(_zoneEnd) - 1; j >= ZONE_START_COL(_zoneStart); j--)   // for each column
+          {
+            uint8_t c = _MX->getColumn(j);
 
-          _MX->setColumn(j + 1, c);
+            setZoneColumn(j + 1, (bUp ? c >> 1 : c << 1) | fill);
+          }
         }
-      }
-      else    // going right
-      {
-        for (int16_t j = ZONE_START_COL(_zoneStart) + 1; j <= ZONE_END_COL(_zoneEnd); j++)   // for each column
+        else    // going right
         {
-          uint8_t c = _MX->getColumn(j);
-
-          c = (bUp ? c >> 1 : c << 1);
-          if (_inverted) c |= (bUp ? 0x80 : 0x01);
+          for (int16_t j = ZONE_START_COL(_zoneStart) + 1; j <= ZONE_END_COL(_zoneEnd); j++)   // for each column
+          {
+            uint8_t c = _MX->getColumn(j);
 
-          _MX->setColumn(j - 1, c);
+            setZoneColumn(j - 1, (bUp ? c >> 1 : c << 1) | fill);
+          }
         }
       }
-     _MX->setColumn((bLeft ? ZONE_START_COL(_zoneStart) : ZONE_END_COL(_zoneEnd)), EMPTY_BAR);  // fill in the end
+     setZoneColumn((bLeft ? ZONE_START_COL(_zoneStart) : ZONE_END_COL(_zoneEnd)), EMPTY_BAR);  // fill in the end
       // check if we have finished
       if (_nextPos == COL_SIZE - 1) _fsmState = END;
 
@@ -43,29 +43,27 @@ void MD_PZone::effectDissolve(bool bIn)
       uint8_t col = DATA_BAR(_MX->getColumn(i));
 
       col |= (i&1 ? 0x55 : 0xaa); // checkerboard pattern
-      _MX->setColumn(i, DATA_BAR(col));
+      setZoneColumn(i, DATA_BAR(col));
     }
     _fsmState = GET_NEXT_CHAR;
     break;
 
   case GET_NEXT_CHAR:   // second stage dissolve
     PRINT_STATE("IO DISS");
-    zoneClear();
-    if (bIn) commonPrint();
+    if (bIn) commonPrint(); else zoneClear();
     for (int16_t i = ZONE_START_COL(_zoneStart); i <= ZONE_END_COL(_zoneEnd); i++)
     {
       uint8_t col = DATA_BAR(_MX->getColumn(i));
 
       col |= (i&1 ? 0xaa : 0x55); // alternate checkerboard pattern
-      _MX->setColumn(i, DATA_BAR(col));
+      setZoneColumn(i, DATA_BAR(col));
     }
     _fsmState = PUT_CHAR;
     break;
 
   case PUT_CHAR:
     PRINT_STATE("IO DISS");
-    zoneClear();
-    if (bIn) commonPrint();
+    if (bIn) commonPrint(); else zoneClear();
     _fsmState = (bIn ? PAUSE : END);
     break;
 
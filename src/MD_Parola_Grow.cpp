@@ -65,7 +65,7 @@ void MD_PZone::effectGrow(bool bUp, bool bIn)
       {
         uint8_t c = DATA_BAR(_MX->getColumn(i)) & (bUp ? ~_nextPos : _nextPos);
 
-        _MX->setColumn(i, DATA_BAR(c));
+        setZoneColumn(i, DATA_BAR(c));
       }
 
       // for the next time around
@@ -104,7 +104,7 @@ void MD_PZone::effectGrow(bool bUp, bool bIn)
       {
         uint8_t c = DATA_BAR(_MX->getColumn(i)) & (bUp ? ~_nextPos : _nextPos);
 
-        _MX->setColumn(i, DATA_BAR(c));
+        setZoneColumn(i, DATA_BAR(c));
       }
 
       // check if we have finished
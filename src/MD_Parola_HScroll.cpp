@@ -71,7 +71,7 @@ void MD_PZone::effectHScroll(bool bLeft, bool bIn)
       if (_charCols != 0)
       {
         _MX->transform(_zoneStart, _zoneEnd, bLeft ? MD_MAX72XX::TSL : MD_MAX72XX::TSR);
-        _MX->setColumn(START_POSITION, DATA_BAR(_cBuf[_countCols++]));
+        setZoneColumn(START_POSITION, DATA_BAR(_cBuf[_countCols++]));
         FSMPRINTS(", scroll");
       }
 
@@ -94,7 +94,7 @@ void MD_PZone::effectHScroll(bool bLeft, bool bIn)
       PRINT_STATE("I HSCROLL");
 
       _MX->transform(_zoneStart, _zoneEnd, bLeft ? MD_MAX72XX::TSL : MD_MAX72XX::TSR);
-      _MX->setColumn(START_POSITION, EMPTY_BAR);
+      setZoneColumn(START_POSITION, EMPTY_BAR);
       FSMPRINTS(", fill");
 
       if (--_countCols == 0)
@@ -112,6 +112,22 @@ void MD_PZone::effectHScroll(bool bLeft, bool bIn)
     {
     case PAUSE:
       PRINT_STATE("O HSCROLL");
+      // Count the blank columns already at the start edge of the zone. Each
+      // frame shifts in one more blank column, so the blank space between
+      // messages can then be tracked without reading back the display.
+      _countCols = 0;
+      if (bLeft)
+      {
+        for (int16_t i = ZONE_START_COL(_zoneStart);
+            (i <= ZONE_END_COL(_zoneEnd)) && (_MX->getColumn(i) == EMPTY_BAR);
+             i++, _countCols++);
+      }
+      else
+      {
+        for (int16_t i = ZONE_END_COL(_zoneEnd);
+            (i >= ZONE_START_COL(_zoneStart)) && (_MX->getColumn(i) == EMPTY_BAR);
+            i--, _countCols++);
+      }
       _fsmState = PUT_FILLER;
       FSMPRINTS(" falling thru");
       // fall through
@@ -119,29 +135,17 @@ void MD_PZone::effectHScroll(bool bLeft, bool bIn)
     case PUT_FILLER:
       PRINT_STATE("O HSCROLL");
       _MX->transform(_zoneStart, _zoneEnd, bLeft ? MD_MAX72XX::TSL : MD_MAX72XX::TSR);
-      _MX->setColumn(START_POSITION, EMPTY_BAR);
+      setZoneColumn(START_POSITION, EMPTY_BAR);
+      _countCols++;
 
       // check if enough scrolled off to say that new message should start
-      // how we count depends on the direction for scrolling
       {
-        uint16_t  spaceCount = 0;
+        uint16_t  spaceCount = _countCols;
         uint16_t  maxCount = (_zoneEnd - _zoneStart + 1) * COL_SIZE;
 
+        if (spaceCount > maxCount) spaceCount = maxCount;
         if ((_scrollDistance != 0) && (maxCount > _scrollDistance)) maxCount = _scrollDistance;
 
-        if (bLeft)
-        {
-          for (int16_t i = ZONE_START_COL(_zoneStart);
-              (i <= ZONE_END_COL(_zoneEnd)) && (_MX->getColumn(i) == EMPTY_BAR);
-               i++, spaceCount++);
-        }
-        else
-        {
-          for (int16_t i = ZONE_END_COL(_zoneEnd);
-              (i >= ZONE_START_COL(_zoneStart)) && (_MX->getColumn(i) == EMPTY_BAR);
-              i--, spaceCount++);
-        }
-
         if (maxCount <= spaceCount) _fsmState = END;  // enough of a space between messages, end this FSM
       }
       break;
@@ -50,7 +50,6 @@ void MD_PZone::effectMesh(bool bIn)
     case PAUSE:
       PRINT_STATE("I MESH");
 
-      zoneClear();
       commonPrint();
 
       for (uint16_t c = ZONE_START_COL(_zoneStart); c <= ZONE_END_COL(_zoneEnd); c++)
@@ -62,7 +61,7 @@ void MD_PZone::effectMesh(bool bIn)
         uint8_t col = _MX->getColumn(c);
 
         col = (bUp ? col >> (COL_SIZE - 1 - _nextPos) : col << (COL_SIZE - 1 - _nextPos));
-        _MX->setColumn(c, col);
+        setZoneColumn(c, col);
         bUp = !bUp;
       }
 
@@ -97,7 +96,7 @@ void MD_PZone::effectMesh(bool bIn)
         uint8_t col = _MX->getColumn(c);
 
         col = (bUp ? col << _nextPos : col >> _nextPos);
-        _MX->setColumn(c, col);
+        setZoneColumn(c, col);
         bUp = !bUp;
       }
 
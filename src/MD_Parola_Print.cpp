@@ -27,13 +27,82 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
  * \brief Implements static print effect
  */
 
-void MD_PZone::commonPrint(void)
+bool MD_PZone::renderText(void)
+// Render the text into the cache buffer, column by column in the same order
+// that commonPrint() places them on the display. The cache is only rebuilt
+// if it has been invalidated or the direction of the text has changed.
+// Return false if the cache memory cannot be allocated.
+{
+  bool bReverse = _textReverse;
+  int16_t size = _limitLeft - _limitRight + 1;
+
+  if (_renderValid && (_renderReverse == bReverse))
+    return(true);
+
+  PRINT("\nrenderText: size=", size);
+  if (size < 0) size = 0;
+  if (size > (int16_t)_renderSize)
+  {
+    delete[] _renderBuf;
+    _renderBuf = new uint8_t[size];
+    _renderSize = (_renderBuf == nullptr ? 0 : size);
+    if (_renderBuf == nullptr)
+      return(false);
+  }
+
+  getFirstChar(_charCols);
+  _countCols = 0;
+
+  for (int16_t i = 0; i < size; )
+  {
+    if (_countCols == _charCols || _charCols == 0)
+    {
+      if (!getNextChar(_charCols))
+      {
+        memset(&_renderBuf[i], 0, size - i);  // ran out of text, blank the rest
+        break;
+      }
+      _countCols = 0;
+    }
+
+    if (_charCols != 0)
+      _renderBuf[i++] = _cBuf[_countCols++];
+  }
+
+  _renderReverse = bReverse;
+  _renderValid = true;
+
+  return(true);
+}
+
+void MD_PZone::commonPrint(int8_t shift)
+// Print the text in the zone. The text columns are shifted up (shift > 0) or
+// down (shift < 0) by the number of pixels specified, filling the vacated
+// pixels with the background. Blank columns are not affected by the shift.
 {
   int16_t nextPos;
+  uint8_t sl = (shift > 0 ? shift : 0);   // left shift (up)
+  uint8_t sr = (shift < 0 ? -shift : 0);  // right shift (down)
+  uint8_t fill = (_inverted ? (uint8_t)((1 << sl) - 1) | (uint8_t)~(0xff >> sr) : 0);
 
   PRINTS("\ncommonPrint");
-  zoneClear();
+
+  // blank the zone either side of the text
+  for (nextPos = ZONE_END_COL(_zoneEnd); nextPos > _limitLeft; nextPos--)
+    setZoneColumn(nextPos, EMPTY_BAR);
+  for (nextPos = ZONE_START_COL(_zoneStart); nextPos < _limitRight; nextPos++)
+    setZoneColumn(nextPos, EMPTY_BAR);
+
   nextPos = _limitLeft;
+
+  if (_renderCache && renderText())
+  {
+    // just copy the pre-rendered columns
+    for (uint16_t i = 0; nextPos >= _limitRight; i++)
+      setZoneColumn(nextPos--, (((uint8_t)DATA_BAR(_renderBuf[i]) << sl) >> sr) | fill);
+    return;
+  }
+
   getFirstChar(_charCols);
   _countCols = 0;
 
@@ -49,7 +118,7 @@ void MD_PZone::commonPrint(void)
 
     // now put something on the display
     if (_charCols != 0)
-      _MX->setColumn(nextPos--, DATA_BAR(_cBuf[_countCols++]));
+      setZoneColumn(nextPos--, (((uint8_t)DATA_BAR(_cBuf[_countCols++]) << sl) >> sr) | fill);
   }
 }
 
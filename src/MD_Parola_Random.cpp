@@ -29,12 +29,17 @@ Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
 
 #if ENA_MISC
 
-#define RAND_CYCLE 11  // random effect repeats every RANDOM_CYCLE columns
+#define RANDOM_CELLS  (RANDOM_CYCLE * ROW_SIZE)  // number of pixels in the mask
+#define LFSR_TAPS     0x60  // taps for a 7 bit maximal length Galois LFSR (x^7 + x^6 + 1)
 
 void MD_PZone::effectRandom(bool bIn)
-// Text enters as random dots
+// Text enters as random dots.
+// The pixels in the mask are visited in the order generated by a 7 bit LFSR,
+// which produces every value 1-127 once before repeating. Values outside the
+// range of the mask are skipped (never more than 2 in a row), so each frame
+// turns on one new pixel in constant time and the effect always completes
+// in RANDOM_CELLS frames.
 {
-  static uint8_t pix[RAND_CYCLE];  // pixel data (one byte per column) to mask the display
   uint8_t c, r;   // the row and column coordinates being considered
 
 switch (_fsmState)
@@ -42,8 +47,9 @@ switch (_fsmState)
   case INITIALISE:    // Entry bIn == true
   case PAUSE:         // Exit  bIn == false
     PRINT_STATE("IO RAND");
-    for (uint8_t i = 0; i < RAND_CYCLE; i++)
-      pix[i] = 0;
+    memset(_fx.random.mask, 0, sizeof(_fx.random.mask));
+    _fx.random.lfsr = random(1, 128);   // random start point in the sequence, never 0
+    _nextPos = 0;
 
     _fsmState = PUT_CHAR;
     // fall through to next state
@@ -54,47 +60,42 @@ switch (_fsmState)
     PRINT_STATE("IO RAND");
     if (bIn) FSMPRINTS(" in"); else FSMPRINTS(" out");
 
-    // Work out and set the next random pixel in the column mask.
-    // Use a loop counter to make sure we just don't loop forever.
-    _nextPos = 0;
+    // Work out and set the next pixel in the column mask.
     do
     {
-      c = random(RAND_CYCLE);
-      r = random(ROW_SIZE);
-      _nextPos++;
-    } while (pix[c] & (1 << r) && _nextPos < 5000);
+      uint8_t lsb = _fx.random.lfsr & 1;
 
-    // FSMPRINT("\n [r,c]=", r); FSMPRINT(",", c); FSMPRINT(" counter ", _nextPos);
+      _fx.random.lfsr >>= 1;
+      if (lsb) _fx.random.lfsr ^= LFSR_TAPS;
+    } while (_fx.random.lfsr > RANDOM_CELLS);
 
-    pix[c] |= (1 << r); // set the r,c location in the mask
+    c = (_fx.random.lfsr - 1) / ROW_SIZE;
+    r = (_fx.random.lfsr - 1) % ROW_SIZE;
+    _fx.random.mask[c] |= (1 << r); // set the r,c location in the mask
+    _nextPos++;
+
+    // FSMPRINT("\n [r,c]=", r); FSMPRINT(",", c); FSMPRINT(" count ", _nextPos);
 
     // set up a new display
     commonPrint();
 
-    // now mask each column by the pixel mask - this repeats every RAND_CYCLE columns, but the
+    // now mask each column by the pixel mask - this repeats every RANDOM_CYCLE columns, but the
     // characters don't occupy every pixel so the effect looks 'random' across the whole display.
-    _nextPos = 0;
-    for (uint16_t c = ZONE_START_COL(_zoneStart); c <= ZONE_END_COL(_zoneEnd); c++)
+    c = 0;
+    for (uint16_t i = ZONE_START_COL(_zoneStart); i <= ZONE_END_COL(_zoneEnd); i++)
     {
-      uint8_t col = _MX->getColumn(c);
+      uint8_t col = _MX->getColumn(i);
 
-      col &= (bIn ? pix[_nextPos] : ~pix[_nextPos]);  // set or reset the bit (depends on bIn)
-      _MX->setColumn(c, col);
+      col &= (bIn ? _fx.random.mask[c] : ~_fx.random.mask[c]);  // set or reset the bit (depends on bIn)
+      setZoneColumn(i, col);
 
-      _nextPos++;
-      if (_nextPos == RAND_CYCLE)
-        _nextPos = 0;
+      c++;
+      if (c == RANDOM_CYCLE)
+        c = 0;
     }
 
-    // check if we have finished. This is when all the columns have pixels all on (0xff)
-    {
-      bool bEnd = true;
-
-      for (uint8_t i = 0; bEnd && i < COL_SIZE; i++)
-        bEnd = (pix[i] == 0xff);
-
-      if (bEnd) _fsmState = (bIn ? PAUSE : END);
-      }
+    // check if we have finished. This is when all the pixels in the mask are on.
+    if (_nextPos == RANDOM_CELLS) _fsmState = (bIn ? PAUSE : END);
     break;
 
   default:
@@ -64,7 +64,7 @@ void MD_PZone::effectHScan(bool bIn, bool bBlank)
       for (int16_t i = _startPos; i != _endPos + _posOffset; i += _posOffset)
       {
         if ((!bBlank && (i != _nextPos)) || (bBlank && (i == _nextPos)))
-          _MX->setColumn(i, EMPTY_BAR);
+          setZoneColumn(i, EMPTY_BAR);
       }
 
       _nextPos += _posOffset; // for the next time around
@@ -97,7 +97,7 @@ void MD_PZone::effectHScan(bool bIn, bool bBlank)
       for (int16_t i = _startPos; i != _endPos + _posOffset; i += _posOffset)
       {
         if ((!bBlank && (i != _nextPos)) || (bBlank && (i == _nextPos)))
-          _MX->setColumn(i, EMPTY_BAR);
+          setZoneColumn(i, EMPTY_BAR);
       }
 
       // check if we have finished
@@ -154,7 +154,7 @@ void MD_PZone::effectVScan(bool bIn, bool bBlank)
       {
         uint8_t c = DATA_BAR(_MX->getColumn(i) & (bBlank ? ~maskCol : maskCol));
 
-        _MX->setColumn(i, DATA_BAR(c));
+        setZoneColumn(i, DATA_BAR(c));
       }
 
       _nextPos++; // for the next time around
@@ -192,7 +192,7 @@ void MD_PZone::effectVScan(bool bIn, bool bBlank)
       {
         uint8_t c = DATA_BAR(_MX->getColumn(i) & (bBlank ? ~maskCol : maskCol));
 
-        _MX->setColumn(i, DATA_BAR(c));
+        setZoneColumn(i, DATA_BAR(c));
       }
 
       // check if we have finished
@@ -78,7 +78,7 @@ void MD_PZone::effectSlice(bool bIn)
       // if the text is too long for the zone, stop when we are at the last column of the zone
       if (_nextPos == _endPos)
       {
-        _MX->setColumn(_nextPos, DATA_BAR(_cBuf[_countCols]));
+        setZoneColumn(_nextPos, DATA_BAR(_cBuf[_countCols]));
         _fsmState = PAUSE;
         break;
       }
@@ -90,9 +90,9 @@ void MD_PZone::effectSlice(bool bIn)
       else  // something to animate
       {
         // clear the column and animate the next one
-        if (_nextPos != _endPos) _MX->setColumn(_nextPos, EMPTY_BAR);
+        if (_nextPos != _endPos) setZoneColumn(_nextPos, EMPTY_BAR);
         _nextPos++;
-        _MX->setColumn(_nextPos, DATA_BAR(_cBuf[_countCols]));
+        setZoneColumn(_nextPos, DATA_BAR(_cBuf[_countCols]));
       }
 
       // set up for the next time
@@ -135,8 +135,8 @@ void MD_PZone::effectSlice(bool bIn)
       {
         // Move the column over to the left and blank out previous position
         if (_nextPos < ZONE_END_COL(_zoneEnd))
-          _MX->setColumn(_nextPos + 1, _MX->getColumn(_nextPos));
-        _MX->setColumn(_nextPos, EMPTY_BAR);
+          setZoneColumn(_nextPos + 1, _MX->getColumn(_nextPos));
+        setZoneColumn(_nextPos, EMPTY_BAR);
         _nextPos++;
 
         // set up for the next time
@@ -70,13 +70,13 @@ void MD_PZone::effectSprite(bool bIn, uint8_t id)
       for (uint8_t i = 0; i < _spriteInWidth; i++)
       {
         if ((_nextPos + i) <= ZONE_END_COL(_zoneEnd) && (_nextPos + i) >= ZONE_START_COL(_zoneStart))
-          _MX->setColumn(_nextPos + i, DATA_BAR(pgm_read_byte(_spriteInData + (_posOffset * _spriteInWidth) + i)));
+          setZoneColumn(_nextPos + i, DATA_BAR(pgm_read_byte(_spriteInData + (_posOffset * _spriteInWidth) + i)));
       }
 
       // blank out the part of the display we don't need
       // this is the part to the right of the sprite
       for (int16_t i = _nextPos - 1; i >= _endPos; i--)
-        _MX->setColumn(i, EMPTY_BAR);
+        setZoneColumn(i, EMPTY_BAR);
 
       // advance the animation frame
       _posOffset++;
@@ -128,13 +128,13 @@ void MD_PZone::effectSprite(bool bIn, uint8_t id)
       for (uint8_t i = 0; i < _spriteOutWidth; i++)
       {
         if ((_nextPos - i) <= ZONE_END_COL(_zoneEnd) && (_nextPos - i) >= ZONE_START_COL(_zoneStart))
-          _MX->setColumn(_nextPos - i, DATA_BAR(pgm_read_byte(_spriteOutData + (_posOffset * _spriteOutWidth) + i)));
+          setZoneColumn(_nextPos - i, DATA_BAR(pgm_read_byte(_spriteOutData + (_posOffset * _spriteOutWidth) + i)));
       }
 
       // blank out the part of the display we don't need
       // this is the part to the right of the sprite
       for (int16_t i = _nextPos - _spriteOutWidth; i >= _endPos; i--)
-        _MX->setColumn(i, EMPTY_BAR);
+        setZoneColumn(i, EMPTY_BAR);
 
       // advance the animation frame
       _posOffset++;
@@ -47,25 +47,12 @@ void MD_PZone::effectVScroll(bool bUp, bool bIn)
     case PAUSE:
       PRINT_STATE("I VSCROLL");
 
-      zoneClear();
-      commonPrint();
-
-      // scroll each column of the zone so that the message appears to be animated
+      // print the message scrolled by the current position so that it appears to
+      // be animated.
       // Note: Directions are reversed here because we start with the message in the
-      // middle position thru commonPrint() and to see it animated moving DOWN we
-      // need to scroll it UP, and vice versa.
-      for (int16_t j = ZONE_START_COL(_zoneStart); j <= ZONE_END_COL(_zoneEnd); j++)   // for each column
-      {
-        uint8_t c = _MX->getColumn(j);
-
-        for (int16_t i = _nextPos; i > 0; i--)
-        {
-          c = (bUp ? c << 1 : c >> 1);
-          if (_inverted) c |= (bUp ? 0x01 : 0x80);
-        }
-
-        _MX->setColumn(j, c);
-      }
+      // middle position and to see it animated moving DOWN we need to scroll it UP,
+      // and vice versa.
+      commonPrint(bUp ? _nextPos : -_nextPos);
 
       // check if we have finished
       if (_nextPos == 0) _fsmState = PAUSE;
@@ -93,15 +80,15 @@ void MD_PZone::effectVScroll(bool bUp, bool bIn)
     case GET_NEXT_CHAR:
     case PUT_CHAR:
       PRINT_STATE("O VSCROLL");
-
-      for (int16_t j = ZONE_START_COL(_zoneStart); j <= ZONE_END_COL(_zoneEnd); j++)   // for each column
       {
-        uint8_t c = _MX->getColumn(j);
+        uint8_t fill = (_inverted ? (bUp ? 0x80 : 0x01) : 0);
 
-        c = (bUp ? c >> 1 : c << 1);
-        if (_inverted) c |= (bUp ? 0x80 : 0x01);
+        for (int16_t j = ZONE_START_COL(_zoneStart); j <= ZONE_END_COL(_zoneEnd); j++)   // for each column
+        {
+          uint8_t c = _MX->getColumn(j);
 
-        _MX->setColumn(j, c);
+          setZoneColumn(j, (bUp ? c >> 1 : c << 1) | fill);
+        }
       }
 
       // check if we have finished
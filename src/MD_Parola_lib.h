@@ -8,7 +8,6 @@
 
 #define DEBUG_PAROLA      0 ///< Set to 1 to enable General debug output
 #define DEBUG_PAROLA_FSM  0 ///< Set to 1 to enable Finite State Machine debug output
-#define TIME_PROFILING    0 ///< Set to 1 to enable Time Profile debug output
 
 #if  DEBUG_PAROLA
 #define PRINT(s, v) { Serial.print(F(s)); Serial.print(v); }    ///< (GENERAL) Print a string followed by a value (decimal)
@@ -45,6 +44,11 @@
 #define ZE_FLIP_UD_MASK 0x01  ///< mask bit 0
 #define ZE_FLIP_LR_MASK 0x02  ///< mask bit 1
 
+// Markup text run settings
+#define RUN_SPACING_ZONE 0xff ///< run uses the zone character spacing
+#define RUN_INVERT  0x01      ///< run characters are inverted
+#define RUN_GLYPH   0x02      ///< run is one byte used as the character code
+
 #define SFX(s) ((_moveIn && _effectIn == (s)) || (!_moveIn && _effectOut == (s))) ///< Effect is selected if it is the effect for the current motion
 
 #define DEFAULT_INTENSITY 7   ///< Startup default intensity setting
\ No newline at end of file